@@ -0,0 +1,118 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/benchmarks/CMakeLists.txt"
+  "/root/repo/cmake/FindGMock.cmake"
+  "/root/repo/cmake/TestHelper.cmake"
+  "/root/repo/examples/CMakeLists.txt"
+  "/root/repo/libcmdly/CMakeLists.txt"
+  "/root/repo/libcmdly/tests/CMakeLists.txt"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GMockTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GMockTargets.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GTestConfig.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GTestConfigVersion.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GTestTargets-none.cmake"
+  "/usr/lib/x86_64-linux-gnu/cmake/GTest/GTestTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindDependencyMacro.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindGTest.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GoogleTest.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libcmdly/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "libcmdly/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "examples/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "benchmarks/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "libcmdly/CMakeFiles/cmdly_object.dir/DependInfo.cmake"
+  "libcmdly/CMakeFiles/cmdly.dir/DependInfo.cmake"
+  "libcmdly/CMakeFiles/cmdly_static.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_command_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_completion_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_coroutine_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_cursor_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_decoder_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_dummy_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_fuzzy_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_gap_buffer_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_highlight_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_history_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_io_resize_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_io_signal_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_line_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_motion_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_queue_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_reactor_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_recording_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_screen_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_server_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_style_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_terminal_basic_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_terminal_batch_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_terminal_nonblocking_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_terminal_posttext_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_terminal_rawmode_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_terminal_readline_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_terminal_writetext_test.dir/DependInfo.cmake"
+  "libcmdly/tests/CMakeFiles/libcmdly_utf8_test.dir/DependInfo.cmake"
+  "examples/CMakeFiles/advanced_terminal.dir/DependInfo.cmake"
+  "examples/CMakeFiles/basic_terminal.dir/DependInfo.cmake"
+  "examples/CMakeFiles/coroutine_console.dir/DependInfo.cmake"
+  "examples/CMakeFiles/event_loop.dir/DependInfo.cmake"
+  "examples/CMakeFiles/session_server.dir/DependInfo.cmake"
+  "examples/CMakeFiles/stdio_reader.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/batch_benchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/completion_benchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/coroutine_benchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/latency_benchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/line_edit_benchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/rawmode_benchmark.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/replay.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/session_load.dir/DependInfo.cmake"
+  "benchmarks/CMakeFiles/check_latency.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/batch_benchmark.dir/batch_benchmark.cpp.o"
+  "CMakeFiles/batch_benchmark.dir/batch_benchmark.cpp.o.d"
+  "batch_benchmark"
+  "batch_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/batch_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/completion_benchmark.dir/completion_benchmark.cpp.o"
+  "CMakeFiles/completion_benchmark.dir/completion_benchmark.cpp.o.d"
+  "completion_benchmark"
+  "completion_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/completion_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
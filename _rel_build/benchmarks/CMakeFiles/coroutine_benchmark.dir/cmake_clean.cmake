@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/coroutine_benchmark.dir/coroutine_benchmark.cpp.o"
+  "CMakeFiles/coroutine_benchmark.dir/coroutine_benchmark.cpp.o.d"
+  "coroutine_benchmark"
+  "coroutine_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/coroutine_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
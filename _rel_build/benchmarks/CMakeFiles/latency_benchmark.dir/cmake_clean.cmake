@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/latency_benchmark.dir/latency_benchmark.cpp.o"
+  "CMakeFiles/latency_benchmark.dir/latency_benchmark.cpp.o.d"
+  "latency_benchmark"
+  "latency_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/latency_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
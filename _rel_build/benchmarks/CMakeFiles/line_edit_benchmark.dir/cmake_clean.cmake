@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/line_edit_benchmark.dir/line_edit_benchmark.cpp.o"
+  "CMakeFiles/line_edit_benchmark.dir/line_edit_benchmark.cpp.o.d"
+  "line_edit_benchmark"
+  "line_edit_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/line_edit_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/rawmode_benchmark.dir/rawmode_benchmark.cpp.o"
+  "CMakeFiles/rawmode_benchmark.dir/rawmode_benchmark.cpp.o.d"
+  "rawmode_benchmark"
+  "rawmode_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rawmode_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
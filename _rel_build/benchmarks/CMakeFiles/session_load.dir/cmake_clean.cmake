@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/session_load.dir/session_load.cpp.o"
+  "CMakeFiles/session_load.dir/session_load.cpp.o.d"
+  "session_load"
+  "session_load.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/session_load.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
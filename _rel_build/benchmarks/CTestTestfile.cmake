@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/benchmarks
+# Build directory: /root/repo/_rel_build/benchmarks
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(check_latency "/root/repo/_rel_build/benchmarks/latency_benchmark" "--rounds" "50" "--max-p99-us" "5000" "--max-bytes-per-key" "256" "--max-syscalls-per-key" "4")
+set_tests_properties(check_latency PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/benchmarks/CMakeLists.txt;22;add_test;/root/repo/benchmarks/CMakeLists.txt;0;")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/advanced_terminal.dir/advanced_terminal.cpp.o"
+  "CMakeFiles/advanced_terminal.dir/advanced_terminal.cpp.o.d"
+  "advanced_terminal"
+  "advanced_terminal.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/advanced_terminal.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
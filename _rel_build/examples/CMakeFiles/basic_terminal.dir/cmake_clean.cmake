@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/basic_terminal.dir/basic_terminal.cpp.o"
+  "CMakeFiles/basic_terminal.dir/basic_terminal.cpp.o.d"
+  "basic_terminal"
+  "basic_terminal.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/basic_terminal.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/coroutine_console.dir/coroutine_console.cpp.o"
+  "CMakeFiles/coroutine_console.dir/coroutine_console.cpp.o.d"
+  "coroutine_console"
+  "coroutine_console.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/coroutine_console.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
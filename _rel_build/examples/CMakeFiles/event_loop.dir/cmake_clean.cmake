@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/event_loop.dir/event_loop.cpp.o"
+  "CMakeFiles/event_loop.dir/event_loop.cpp.o.d"
+  "event_loop"
+  "event_loop.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/event_loop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/session_server.dir/session_server.cpp.o"
+  "CMakeFiles/session_server.dir/session_server.cpp.o.d"
+  "session_server"
+  "session_server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/session_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
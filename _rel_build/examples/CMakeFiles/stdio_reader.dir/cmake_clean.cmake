@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/stdio_reader.dir/stdio_reader.cpp.o"
+  "CMakeFiles/stdio_reader.dir/stdio_reader.cpp.o.d"
+  "stdio_reader"
+  "stdio_reader.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/stdio_reader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
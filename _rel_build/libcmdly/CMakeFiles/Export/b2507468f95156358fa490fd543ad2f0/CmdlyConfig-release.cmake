@@ -0,0 +1,29 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Release".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "Cmdly::cmdly" for configuration "Release"
+set_property(TARGET Cmdly::cmdly APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(Cmdly::cmdly PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libcmdly.so"
+  IMPORTED_SONAME_RELEASE "libcmdly.so"
+  )
+
+list(APPEND _cmake_import_check_targets Cmdly::cmdly )
+list(APPEND _cmake_import_check_files_for_Cmdly::cmdly "${_IMPORT_PREFIX}/lib/libcmdly.so" )
+
+# Import target "Cmdly::cmdly_static" for configuration "Release"
+set_property(TARGET Cmdly::cmdly_static APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(Cmdly::cmdly_static PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libcmdly_static.a"
+  )
+
+list(APPEND _cmake_import_check_targets Cmdly::cmdly_static )
+list(APPEND _cmake_import_check_files_for_Cmdly::cmdly_static "${_IMPORT_PREFIX}/lib/libcmdly_static.a" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libcmdly.pdb"
+  "libcmdly.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cmdly.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libcmdly/src/command.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/command.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/command.cpp.o.d"
+  "/root/repo/libcmdly/src/completion.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/completion.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/completion.cpp.o.d"
+  "/root/repo/libcmdly/src/coroutine.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/coroutine.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/coroutine.cpp.o.d"
+  "/root/repo/libcmdly/src/fuzzy.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/fuzzy.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/fuzzy.cpp.o.d"
+  "/root/repo/libcmdly/src/key.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/key.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/key.cpp.o.d"
+  "/root/repo/libcmdly/src/reactor.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/reactor.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/reactor.cpp.o.d"
+  "/root/repo/libcmdly/src/recording.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/recording.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/recording.cpp.o.d"
+  "/root/repo/libcmdly/src/server.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/server.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/server.cpp.o.d"
+  "/root/repo/libcmdly/src/terminal.cpp" "libcmdly/CMakeFiles/cmdly_object.dir/src/terminal.cpp.o" "gcc" "libcmdly/CMakeFiles/cmdly_object.dir/src/terminal.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,25 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cmdly_object.dir/src/command.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/command.cpp.o.d"
+  "CMakeFiles/cmdly_object.dir/src/completion.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/completion.cpp.o.d"
+  "CMakeFiles/cmdly_object.dir/src/coroutine.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/coroutine.cpp.o.d"
+  "CMakeFiles/cmdly_object.dir/src/fuzzy.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/fuzzy.cpp.o.d"
+  "CMakeFiles/cmdly_object.dir/src/key.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/key.cpp.o.d"
+  "CMakeFiles/cmdly_object.dir/src/reactor.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/reactor.cpp.o.d"
+  "CMakeFiles/cmdly_object.dir/src/recording.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/recording.cpp.o.d"
+  "CMakeFiles/cmdly_object.dir/src/server.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/server.cpp.o.d"
+  "CMakeFiles/cmdly_object.dir/src/terminal.cpp.o"
+  "CMakeFiles/cmdly_object.dir/src/terminal.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cmdly_object.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
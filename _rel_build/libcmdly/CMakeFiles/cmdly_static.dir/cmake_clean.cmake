@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "libcmdly_static.a"
+  "libcmdly_static.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cmdly_static.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,127 @@
+# Install script for directory: /root/repo/libcmdly
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "development" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/cmdly" TYPE FILE FILES
+    "/root/repo/libcmdly/include/cmdly/command.h"
+    "/root/repo/libcmdly/include/cmdly/completion.h"
+    "/root/repo/libcmdly/include/cmdly/coroutine.h"
+    "/root/repo/libcmdly/include/cmdly/cursor.h"
+    "/root/repo/libcmdly/include/cmdly/decoder.h"
+    "/root/repo/libcmdly/include/cmdly/exception.h"
+    "/root/repo/libcmdly/include/cmdly/fuzzy.h"
+    "/root/repo/libcmdly/include/cmdly/gap_buffer.h"
+    "/root/repo/libcmdly/include/cmdly/highlight.h"
+    "/root/repo/libcmdly/include/cmdly/history.h"
+    "/root/repo/libcmdly/include/cmdly/io.h"
+    "/root/repo/libcmdly/include/cmdly/key.h"
+    "/root/repo/libcmdly/include/cmdly/line.h"
+    "/root/repo/libcmdly/include/cmdly/listener.h"
+    "/root/repo/libcmdly/include/cmdly/motion.h"
+    "/root/repo/libcmdly/include/cmdly/queue.h"
+    "/root/repo/libcmdly/include/cmdly/radix_tree.h"
+    "/root/repo/libcmdly/include/cmdly/reactor.h"
+    "/root/repo/libcmdly/include/cmdly/recording.h"
+    "/root/repo/libcmdly/include/cmdly/screen.h"
+    "/root/repo/libcmdly/include/cmdly/server.h"
+    "/root/repo/libcmdly/include/cmdly/split_index.h"
+    "/root/repo/libcmdly/include/cmdly/string.h"
+    "/root/repo/libcmdly/include/cmdly/style.h"
+    "/root/repo/libcmdly/include/cmdly/terminal.h"
+    "/root/repo/libcmdly/include/cmdly/utf8.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "runtime" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libcmdly.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libcmdly.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libcmdly.so"
+         RPATH "")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/_rel_build/libcmdly/libcmdly.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libcmdly.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libcmdly.so")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libcmdly.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "runtime" OR NOT CMAKE_INSTALL_COMPONENT)
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "runtime" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE STATIC_LIBRARY FILES "/root/repo/_rel_build/libcmdly/libcmdly_static.a")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "development" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/export/CmdlyConfig.cmake")
+    file(DIFFERENT _cmake_export_file_changed FILES
+         "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/export/CmdlyConfig.cmake"
+         "/root/repo/_rel_build/libcmdly/CMakeFiles/Export/b2507468f95156358fa490fd543ad2f0/CmdlyConfig.cmake")
+    if(_cmake_export_file_changed)
+      file(GLOB _cmake_old_config_files "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/export/CmdlyConfig-*.cmake")
+      if(_cmake_old_config_files)
+        string(REPLACE ";" ", " _cmake_old_config_files_text "${_cmake_old_config_files}")
+        message(STATUS "Old export file \"$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/export/CmdlyConfig.cmake\" will be replaced.  Removing files [${_cmake_old_config_files_text}].")
+        unset(_cmake_old_config_files_text)
+        file(REMOVE ${_cmake_old_config_files})
+      endif()
+      unset(_cmake_old_config_files)
+    endif()
+    unset(_cmake_export_file_changed)
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/export" TYPE FILE FILES "/root/repo/_rel_build/libcmdly/CMakeFiles/Export/b2507468f95156358fa490fd543ad2f0/CmdlyConfig.cmake")
+  if(CMAKE_INSTALL_CONFIG_NAME MATCHES "^([Rr][Ee][Ll][Ee][Aa][Ss][Ee])$")
+    file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/export" TYPE FILE FILES "/root/repo/_rel_build/libcmdly/CMakeFiles/Export/b2507468f95156358fa490fd543ad2f0/CmdlyConfig-release.cmake")
+  endif()
+endif()
+
+if(NOT CMAKE_INSTALL_LOCAL_ONLY)
+  # Include the install script for each subdirectory.
+  include("/root/repo/_rel_build/libcmdly/tests/cmake_install.cmake")
+
+endif()
+
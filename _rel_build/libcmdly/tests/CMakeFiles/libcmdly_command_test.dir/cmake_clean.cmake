@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_command_test.dir/command_test.cpp.o"
+  "CMakeFiles/libcmdly_command_test.dir/command_test.cpp.o.d"
+  "libcmdly_command_test"
+  "libcmdly_command_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_command_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_completion_test.dir/completion_test.cpp.o"
+  "CMakeFiles/libcmdly_completion_test.dir/completion_test.cpp.o.d"
+  "libcmdly_completion_test"
+  "libcmdly_completion_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_completion_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
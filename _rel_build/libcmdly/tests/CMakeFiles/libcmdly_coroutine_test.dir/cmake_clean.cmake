@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_coroutine_test.dir/coroutine_test.cpp.o"
+  "CMakeFiles/libcmdly_coroutine_test.dir/coroutine_test.cpp.o.d"
+  "libcmdly_coroutine_test"
+  "libcmdly_coroutine_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_coroutine_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_cursor_test.dir/cursor_test.cpp.o"
+  "CMakeFiles/libcmdly_cursor_test.dir/cursor_test.cpp.o.d"
+  "libcmdly_cursor_test"
+  "libcmdly_cursor_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_cursor_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
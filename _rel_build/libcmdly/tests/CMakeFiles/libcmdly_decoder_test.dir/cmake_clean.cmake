@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_decoder_test.dir/decoder_test.cpp.o"
+  "CMakeFiles/libcmdly_decoder_test.dir/decoder_test.cpp.o.d"
+  "libcmdly_decoder_test"
+  "libcmdly_decoder_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_decoder_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_dummy_test.dir/dummy_test.cpp.o"
+  "CMakeFiles/libcmdly_dummy_test.dir/dummy_test.cpp.o.d"
+  "libcmdly_dummy_test"
+  "libcmdly_dummy_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_dummy_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_fuzzy_test.dir/fuzzy_test.cpp.o"
+  "CMakeFiles/libcmdly_fuzzy_test.dir/fuzzy_test.cpp.o.d"
+  "libcmdly_fuzzy_test"
+  "libcmdly_fuzzy_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_fuzzy_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
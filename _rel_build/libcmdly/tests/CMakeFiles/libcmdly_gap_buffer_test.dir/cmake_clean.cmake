@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_gap_buffer_test.dir/gap_buffer_test.cpp.o"
+  "CMakeFiles/libcmdly_gap_buffer_test.dir/gap_buffer_test.cpp.o.d"
+  "libcmdly_gap_buffer_test"
+  "libcmdly_gap_buffer_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_gap_buffer_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_highlight_test.dir/highlight_test.cpp.o"
+  "CMakeFiles/libcmdly_highlight_test.dir/highlight_test.cpp.o.d"
+  "libcmdly_highlight_test"
+  "libcmdly_highlight_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_highlight_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_history_test.dir/history_test.cpp.o"
+  "CMakeFiles/libcmdly_history_test.dir/history_test.cpp.o.d"
+  "libcmdly_history_test"
+  "libcmdly_history_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_history_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_io_resize_test.dir/io_resize_test.cpp.o"
+  "CMakeFiles/libcmdly_io_resize_test.dir/io_resize_test.cpp.o.d"
+  "libcmdly_io_resize_test"
+  "libcmdly_io_resize_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_io_resize_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
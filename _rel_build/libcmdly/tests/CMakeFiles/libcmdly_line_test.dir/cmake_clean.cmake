@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_line_test.dir/line_test.cpp.o"
+  "CMakeFiles/libcmdly_line_test.dir/line_test.cpp.o.d"
+  "libcmdly_line_test"
+  "libcmdly_line_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_line_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_motion_test.dir/motion_test.cpp.o"
+  "CMakeFiles/libcmdly_motion_test.dir/motion_test.cpp.o.d"
+  "libcmdly_motion_test"
+  "libcmdly_motion_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_motion_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
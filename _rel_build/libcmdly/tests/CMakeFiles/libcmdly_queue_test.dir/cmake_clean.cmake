@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_queue_test.dir/queue_test.cpp.o"
+  "CMakeFiles/libcmdly_queue_test.dir/queue_test.cpp.o.d"
+  "libcmdly_queue_test"
+  "libcmdly_queue_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_queue_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_reactor_test.dir/reactor_test.cpp.o"
+  "CMakeFiles/libcmdly_reactor_test.dir/reactor_test.cpp.o.d"
+  "libcmdly_reactor_test"
+  "libcmdly_reactor_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_reactor_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_recording_test.dir/recording_test.cpp.o"
+  "CMakeFiles/libcmdly_recording_test.dir/recording_test.cpp.o.d"
+  "libcmdly_recording_test"
+  "libcmdly_recording_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_recording_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
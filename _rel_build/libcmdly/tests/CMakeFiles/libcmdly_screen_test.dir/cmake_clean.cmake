@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_screen_test.dir/screen_test.cpp.o"
+  "CMakeFiles/libcmdly_screen_test.dir/screen_test.cpp.o.d"
+  "libcmdly_screen_test"
+  "libcmdly_screen_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_screen_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
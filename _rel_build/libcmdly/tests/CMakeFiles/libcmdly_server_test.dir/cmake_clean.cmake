@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_server_test.dir/server_test.cpp.o"
+  "CMakeFiles/libcmdly_server_test.dir/server_test.cpp.o.d"
+  "libcmdly_server_test"
+  "libcmdly_server_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_server_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_style_test.dir/style_test.cpp.o"
+  "CMakeFiles/libcmdly_style_test.dir/style_test.cpp.o.d"
+  "libcmdly_style_test"
+  "libcmdly_style_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_style_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_terminal_nonblocking_test.dir/terminal_nonblocking_test.cpp.o"
+  "CMakeFiles/libcmdly_terminal_nonblocking_test.dir/terminal_nonblocking_test.cpp.o.d"
+  "libcmdly_terminal_nonblocking_test"
+  "libcmdly_terminal_nonblocking_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_terminal_nonblocking_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
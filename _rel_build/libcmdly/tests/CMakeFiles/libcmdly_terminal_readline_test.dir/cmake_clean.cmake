@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_terminal_readline_test.dir/terminal_readline_test.cpp.o"
+  "CMakeFiles/libcmdly_terminal_readline_test.dir/terminal_readline_test.cpp.o.d"
+  "libcmdly_terminal_readline_test"
+  "libcmdly_terminal_readline_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_terminal_readline_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
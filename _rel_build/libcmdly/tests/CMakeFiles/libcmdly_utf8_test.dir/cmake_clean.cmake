@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/libcmdly_utf8_test.dir/utf8_test.cpp.o"
+  "CMakeFiles/libcmdly_utf8_test.dir/utf8_test.cpp.o.d"
+  "libcmdly_utf8_test"
+  "libcmdly_utf8_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/libcmdly_utf8_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
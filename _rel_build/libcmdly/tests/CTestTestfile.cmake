@@ -0,0 +1,62 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libcmdly/tests
+# Build directory: /root/repo/_rel_build/libcmdly/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(libcmdly_command_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_command_test")
+set_tests_properties(libcmdly_command_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_completion_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_completion_test")
+set_tests_properties(libcmdly_completion_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_coroutine_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_coroutine_test")
+set_tests_properties(libcmdly_coroutine_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_cursor_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_cursor_test")
+set_tests_properties(libcmdly_cursor_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_decoder_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_decoder_test")
+set_tests_properties(libcmdly_decoder_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_dummy_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_dummy_test")
+set_tests_properties(libcmdly_dummy_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_fuzzy_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_fuzzy_test")
+set_tests_properties(libcmdly_fuzzy_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_gap_buffer_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_gap_buffer_test")
+set_tests_properties(libcmdly_gap_buffer_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_highlight_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_highlight_test")
+set_tests_properties(libcmdly_highlight_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_history_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_history_test")
+set_tests_properties(libcmdly_history_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_io_resize_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_io_resize_test")
+set_tests_properties(libcmdly_io_resize_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_io_signal_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_io_signal_test")
+set_tests_properties(libcmdly_io_signal_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_line_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_line_test")
+set_tests_properties(libcmdly_line_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_motion_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_motion_test")
+set_tests_properties(libcmdly_motion_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_queue_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_queue_test")
+set_tests_properties(libcmdly_queue_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_reactor_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_reactor_test")
+set_tests_properties(libcmdly_reactor_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_recording_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_recording_test")
+set_tests_properties(libcmdly_recording_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_screen_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_screen_test")
+set_tests_properties(libcmdly_screen_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_server_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_server_test")
+set_tests_properties(libcmdly_server_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_style_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_style_test")
+set_tests_properties(libcmdly_style_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_terminal_basic_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_terminal_basic_test")
+set_tests_properties(libcmdly_terminal_basic_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_terminal_batch_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_terminal_batch_test")
+set_tests_properties(libcmdly_terminal_batch_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_terminal_nonblocking_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_terminal_nonblocking_test")
+set_tests_properties(libcmdly_terminal_nonblocking_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_terminal_posttext_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_terminal_posttext_test")
+set_tests_properties(libcmdly_terminal_posttext_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_terminal_rawmode_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_terminal_rawmode_test")
+set_tests_properties(libcmdly_terminal_rawmode_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_terminal_readline_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_terminal_readline_test")
+set_tests_properties(libcmdly_terminal_readline_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_terminal_writetext_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_terminal_writetext_test")
+set_tests_properties(libcmdly_terminal_writetext_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
+add_test(libcmdly_utf8_test "/root/repo/_rel_build/libcmdly/tests/libcmdly_utf8_test")
+set_tests_properties(libcmdly_utf8_test PROPERTIES  WORKING_DIRECTORY "/root/repo/_rel_build/libcmdly/tests" _BACKTRACE_TRIPLES "/root/repo/cmake/TestHelper.cmake;10;add_test;/root/repo/libcmdly/tests/CMakeLists.txt;4;just_add_test;/root/repo/libcmdly/tests/CMakeLists.txt;0;")
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <cmdly/terminal.h>
+
+using namespace cmdly;
+
+// Writes a script of commands to a temporary file, the same way `app < commands.txt` would see it
+static int createScript(std::size_t lines)
+{
+    char path[] = "/tmp/cmdly_batch_XXXXXX";
+    int fd = ::mkstemp(path);
+    if (fd < 0)
+    {
+        throw IOError("could not create script file");
+    }
+    ::unlink(path);
+
+    std::string script;
+    for (std::size_t i = 0; i < lines; ++i)
+    {
+        script += "set key" + std::to_string(i) + " value\n";
+    }
+    if (::write(fd, script.data(), script.size()) != ssize_t(script.size()))
+    {
+        throw IOError("could not write script file");
+    }
+    ::lseek(fd, 0, SEEK_SET);
+    return fd;
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t lines = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+    int input_fd = createScript(lines);
+    int output_fd = ::open("/dev/null", O_WRONLY);
+    auto io = std::make_shared<StandardIO>(input_fd, output_fd);
+    Terminal terminal(io);
+
+    std::size_t entered = 0;
+    terminal.onLineEntered([&entered](const std::string &, Terminal &terminal) {
+        entered++;
+        terminal.writeText("ok\n", TextStyle(Color::Green));
+        return LineEnteredListener::Status::OK;
+    });
+
+    auto begin = std::chrono::steady_clock::now();
+    terminal.run("> ");
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin);
+
+    const auto &statistics = io->statistics();
+    std::cout << "batch:"
+              << " lines=" << entered
+              << " lines/s=" << std::size_t(double(entered) / elapsed.count())
+              << " reads=" << statistics.reads
+              << " writes=" << statistics.writes
+              << " termios=" << statistics.termios_calls
+              << std::endl;
+
+    ::close(input_fd);
+    ::close(output_fd);
+    return entered == lines ? 0 : 1;
+}
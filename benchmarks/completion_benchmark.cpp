@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <string>
+#include <cmdly/completion.h>
+
+using namespace cmdly;
+
+// Usage: completion_benchmark [searches per size]
+//
+// Cost of completing a phrase among 10K, 100K and 1M words named like objects in a store
+// ("bucket-00042/object-0001337"), for the radix index next to the scan of a std::set it replaced.
+// The phrase is narrow enough to match 100 words whatever the size. Fuzzy matching looks for the 64
+// best words of "b7o137" among all of them, with one thread and with every thread there is.
+
+template<typename Search>
+static double microsecondsPerSearch(std::size_t searches, Search search)
+{
+    auto begin = std::chrono::steady_clock::now();
+    std::size_t found = 0;
+    for (std::size_t i = 0; i < searches; ++i)
+    {
+        found += search(i);
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin);
+    if (found == 0)
+    {
+        std::cerr << "nothing found" << std::endl;
+    }
+    return elapsed.count() / double(searches);
+}
+
+static std::string objectName(std::size_t i)
+{
+    auto bucket = std::to_string(i / 1000);
+    auto object = std::to_string(i % 1000);
+    return "bucket-" + std::string(5 - bucket.size(), '0') + bucket + "/object-" + std::string(7 - object.size(), '0') + object;
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t searches = argc > 1 ? std::stoul(argv[1]) : 100;
+
+    for (std::size_t size : {10000, 100000, 1000000})
+    {
+        Completion completion;
+        std::set<std::string> words;
+        auto begin = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            completion.insert(objectName(i));
+        }
+        auto insert_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            words.insert(objectName(i));
+        }
+
+        // 100 words: one bucket, objects 0000100 to 0000199
+        auto phrase = [size](std::size_t i) {
+            return objectName((i * 7919) % (size / 1000) * 1000 + 100).substr(0, 25);
+        };
+        auto index_us = microsecondsPerSearch(searches, [&](std::size_t i) {
+            return completion.search(phrase(i))->size();
+        });
+        auto scan_us = microsecondsPerSearch(searches, [&](std::size_t i) {
+            auto prefix = phrase(i);
+            std::vector<std::string> found;
+            for (auto &word : words)
+            {
+                if (word.starts_with(prefix))
+                {
+                    found.push_back(word);
+                }
+            }
+            return found.size();
+        });
+
+        completion.setMatching(Completion::Matching::Fuzzy);
+        completion.setFuzzyThreads(1);
+        auto fuzzy_us = microsecondsPerSearch(searches, [&](std::size_t) {
+            return completion.search("b7o137")->size();
+        });
+        completion.setFuzzyThreads(0);
+        auto fuzzy_parallel_us = microsecondsPerSearch(searches, [&](std::size_t) {
+            return completion.search("b7o137")->size();
+        });
+
+        std::cout << "words=" << size
+                  << " insert_ms=" << insert_ms
+                  << " index_us/search=" << index_us
+                  << " set_scan_us/search=" << scan_us
+                  << " fuzzy_us/search=" << fuzzy_us
+                  << " fuzzy_parallel_us/search=" << fuzzy_parallel_us
+                  << std::endl;
+    }
+    return 0;
+}
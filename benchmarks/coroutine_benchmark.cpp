@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cmdly/coroutine.h>
+#include <cmdly/terminal.h>
+
+using namespace cmdly;
+
+// Console reading its keys from a pipe, with output discarded
+class PipeIO : public StandardIO
+{
+public:
+    explicit PipeIO(int fd) :
+        StandardIO(fd, -1)
+    {}
+
+    char getChar() override
+    {
+        static const std::string position = "\033[1;1R";
+        char c = position[position_index_];
+        position_index_ = (position_index_ + 1) % position.size();
+        return c;
+    }
+
+    void write(const std::string &) const override
+    {}
+
+private:
+    std::size_t position_index_{0};
+};
+
+struct Console
+{
+    int fds[2]{-1, -1};
+    std::unique_ptr<Terminal> terminal;
+
+    Console()
+    {
+        if (::pipe(fds) < 0)
+        {
+            throw IOError("could not create pipe");
+        }
+        terminal = std::make_unique<Terminal>(std::make_shared<PipeIO>(fds[0]));
+    }
+
+    ~Console()
+    {
+        terminal.reset();
+        ::close(fds[0]);
+        ::close(fds[1]);
+    }
+};
+
+static long contextSwitches()
+{
+    struct rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_nvcsw + usage.ru_nivcsw;
+}
+
+// Types one line into every console and waits until all of them got it, round after round
+static void drive(std::vector<std::unique_ptr<Console>> &consoles, std::size_t rounds, std::atomic<std::size_t> &entered)
+{
+    for (std::size_t round = 0; round < rounds; ++round)
+    {
+        for (auto &console : consoles)
+        {
+            if (::write(console->fds[1], "cmd\r", 4) != 4)
+            {
+                throw IOError("could not write to pipe");
+            }
+        }
+        while (entered.load(std::memory_order_acquire) < (round + 1) * consoles.size())
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+static void report(const std::string &name, std::size_t lines, std::chrono::nanoseconds elapsed, long switches)
+{
+    std::cout << name << ":"
+              << " lines=" << lines
+              << " ns/line=" << double(elapsed.count()) / double(lines)
+              << " context-switches/line=" << double(switches) / double(lines)
+              << std::endl;
+}
+
+static void runCoroutines(std::size_t console_count, std::size_t rounds)
+{
+    std::vector<std::unique_ptr<Console>> consoles;
+    for (std::size_t i = 0; i < console_count; ++i)
+    {
+        consoles.push_back(std::make_unique<Console>());
+    }
+
+    Executor executor;
+    std::atomic<std::size_t> entered{0};
+    for (auto &console : consoles)
+    {
+        executor.spawn([](Terminal &terminal, std::size_t rounds, std::atomic<std::size_t> &entered) -> Task<> {
+            for (std::size_t i = 0; i < rounds; ++i)
+            {
+                co_await terminal.readLineAsync("> ");
+                entered.fetch_add(1, std::memory_order_release);
+            }
+            terminal.stop();
+        }(*console->terminal, rounds, entered));
+    }
+
+    auto switches = contextSwitches();
+    auto begin = std::chrono::steady_clock::now();
+    std::thread driver(drive, std::ref(consoles), rounds, std::ref(entered));
+    executor.run();
+    driver.join();
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    report("coroutines (1 thread)", console_count * rounds, elapsed, contextSwitches() - switches);
+}
+
+static void runThreads(std::size_t console_count, std::size_t rounds)
+{
+    std::vector<std::unique_ptr<Console>> consoles;
+    for (std::size_t i = 0; i < console_count; ++i)
+    {
+        consoles.push_back(std::make_unique<Console>());
+    }
+
+    std::atomic<std::size_t> entered{0};
+    auto switches = contextSwitches();
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (auto &console : consoles)
+    {
+        threads.emplace_back([&terminal = *console->terminal, rounds, &entered]() {
+            for (std::size_t i = 0; i < rounds; ++i)
+            {
+                terminal.readLine("> ");
+                entered.fetch_add(1, std::memory_order_release);
+            }
+        });
+    }
+    drive(consoles, rounds, entered);
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    report("thread per console (" + std::to_string(console_count) + " threads)", console_count * rounds, elapsed,
+           contextSwitches() - switches);
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t consoles = argc > 1 ? std::stoul(argv[1]) : 100;
+    const std::size_t rounds = argc > 2 ? std::stoul(argv[2]) : 100;
+
+    runCoroutines(consoles, rounds);
+    runThreads(consoles, rounds);
+
+    return 0;
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_BENCHMARKS_HELPERS_PTY_H
+#define CMDLY_BENCHMARKS_HELPERS_PTY_H
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <cstdlib>
+#include <cmdly/exception.h>
+
+// Pseudo-terminal pair used to drive cmdly like a real user would
+class PseudoTerminal
+{
+public:
+    explicit PseudoTerminal(unsigned short cols = 80, unsigned short rows = 24)
+    {
+        master_ = ::posix_openpt(O_RDWR | O_NOCTTY);
+        if (master_ < 0 || ::grantpt(master_) < 0 || ::unlockpt(master_) < 0)
+        {
+            throw cmdly::IOError("could not open pseudo-terminal");
+        }
+        slave_ = ::open(::ptsname(master_), O_RDWR | O_NOCTTY);
+        if (slave_ < 0)
+        {
+            throw cmdly::IOError("could not open pseudo-terminal slave");
+        }
+
+        struct winsize ws = {};
+        ws.ws_col = cols;
+        ws.ws_row = rows;
+        ::ioctl(slave_, TIOCSWINSZ, &ws);
+
+        // the line discipline must not echo on its own, cmdly does it
+        struct termios term{};
+        ::tcgetattr(slave_, &term);
+        term.c_lflag &= ~ECHO;
+        ::tcsetattr(slave_, TCSANOW, &term);
+    }
+
+    ~PseudoTerminal()
+    {
+        ::close(slave_);
+        ::close(master_);
+    }
+
+    PseudoTerminal(const PseudoTerminal &) = delete;
+    PseudoTerminal &operator=(const PseudoTerminal &) = delete;
+
+    [[nodiscard]] int master() const
+    {
+        return master_;
+    }
+
+    [[nodiscard]] int slave() const
+    {
+        return slave_;
+    }
+
+    void send(const std::string &data) const
+    {
+        std::size_t offset = 0;
+        while (offset < data.size())
+        {
+            auto len = ::write(master_, data.data() + offset, data.size() - offset);
+            if (len < 0)
+            {
+                throw cmdly::IOError("could not write to pseudo-terminal");
+            }
+            offset += len;
+        }
+    }
+
+private:
+    int master_{-1};
+    int slave_{-1};
+}; /* End of class PseudoTerminal */
+
+#endif /* !CMDLY_BENCHMARKS_HELPERS_PTY_H */
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <poll.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cmdly/terminal.h>
+#include "helpers/pty.h"
+
+using namespace cmdly;
+
+// Usage: latency_benchmark [--rounds N] [--max-p99-us N] [--max-bytes-per-key N] [--max-syscalls-per-key N]
+//
+// Prints one JSON object, exits with 1 when a limit is exceeded so a build step can fail on regressions.
+
+struct Scenario
+{
+    std::string name;
+    // every key must make the terminal write something, the echo is what gets timed
+    std::vector<std::string> keys;
+};
+
+struct Result
+{
+    std::string name;
+    std::vector<std::chrono::nanoseconds> latencies;
+    std::size_t bytes{0};
+    std::uint64_t syscalls{0};
+
+    [[nodiscard]] double percentile(double p) const
+    {
+        auto sorted = latencies;
+        std::sort(sorted.begin(), sorted.end());
+        auto index = std::size_t(p * double(sorted.size() - 1));
+        return double(sorted[index].count()) / 1000.0;
+    }
+
+    [[nodiscard]] double perKey(double value) const
+    {
+        return value / double(latencies.size());
+    }
+};
+
+static std::vector<std::string> typed(const std::string &text)
+{
+    std::vector<std::string> keys;
+    for (char c : text)
+    {
+        keys.emplace_back(1, c);
+    }
+    return keys;
+}
+
+static std::vector<Scenario> scenarios()
+{
+    std::vector<Scenario> result;
+
+    auto typing = typed("show interfaces brief");
+    typing.emplace_back("\r");
+    result.push_back({"typing", typing});
+
+    auto arrows = typed("abcdefgh");
+    for (int i = 0; i < 8; ++i)
+    {
+        arrows.emplace_back("\033[D");
+    }
+    for (int i = 0; i < 8; ++i)
+    {
+        arrows.emplace_back("\033[C");
+    }
+    arrows.emplace_back("\r");
+    result.push_back({"arrows", arrows});
+
+    result.push_back({"tab", {"h", "\t", "\r"}});
+
+    std::string pasted(200, 'x');
+    result.push_back({"paste", {"\033[200~" + pasted + "\033[201~", "\r"}});
+
+    return result;
+}
+
+// Reads what the terminal wrote: waits for the first byte, then until the output goes quiet
+static std::size_t readEcho(int fd, std::chrono::steady_clock::time_point *first_byte)
+{
+    char buf[4096];
+    std::size_t total = 0;
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int timeout = 1000;
+    while (::poll(&pfd, 1, timeout) > 0)
+    {
+        auto len = ::read(fd, buf, sizeof(buf));
+        if (len <= 0)
+        {
+            break;
+        }
+        if (total == 0)
+        {
+            *first_byte = std::chrono::steady_clock::now();
+        }
+        total += len;
+        timeout = 1;
+    }
+    if (total == 0)
+    {
+        throw IOError("terminal did not answer a key");
+    }
+    return total;
+}
+
+static Result measure(const Scenario &scenario, std::size_t rounds)
+{
+    PseudoTerminal pty;
+    auto io = std::make_shared<StandardIO>(pty.slave(), pty.slave());
+    Terminal terminal(io);
+    terminal.completion()->insert({"hello", "help", "history"});
+    // the counters belong to the terminal thread, which takes a copy of them when asked with ^T
+    std::promise<IO::Statistics> statistics;
+    terminal.onKeyPressed(Key::Ctrl('t'), [&io, &statistics](const Key &, Line &, Cursor &, Terminal &) {
+        statistics.set_value(io->statistics());
+        return KeyPressedListener::Status::CONTINUE;
+    });
+    std::thread thread([&terminal]() { terminal.run("> "); });
+
+    Result result;
+    result.name = scenario.name;
+    std::chrono::steady_clock::time_point first_byte;
+    readEcho(pty.master(), &first_byte);
+    for (std::size_t round = 0; round < rounds; ++round)
+    {
+        for (auto &key : scenario.keys)
+        {
+            auto sent = std::chrono::steady_clock::now();
+            pty.send(key);
+            result.bytes += readEcho(pty.master(), &first_byte);
+            result.latencies.emplace_back(first_byte - sent);
+        }
+    }
+
+    // the prompt and the read of ^T are counted, "exit" is not
+    auto snapshot = statistics.get_future();
+    pty.send(std::string(1, Key::Ctrl('t').code()));
+    auto counted = snapshot.get();
+    pty.send("exit\r");
+    thread.join();
+    result.syscalls = counted.reads + counted.writes + counted.termios_calls;
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    std::size_t rounds = 100;
+    double max_p99_us = 0;
+    double max_bytes_per_key = 0;
+    double max_syscalls_per_key = 0;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--rounds") == 0) { rounds = std::stoul(argv[i + 1]); }
+        else if (std::strcmp(argv[i], "--max-p99-us") == 0) { max_p99_us = std::stod(argv[i + 1]); }
+        else if (std::strcmp(argv[i], "--max-bytes-per-key") == 0) { max_bytes_per_key = std::stod(argv[i + 1]); }
+        else if (std::strcmp(argv[i], "--max-syscalls-per-key") == 0) { max_syscalls_per_key = std::stod(argv[i + 1]); }
+    }
+
+    bool failed = false;
+    std::cout << "{\"benchmark\": \"latency\", \"rounds\": " << rounds << ", \"scenarios\": [";
+    const char *separator = "";
+    for (auto &scenario : scenarios())
+    {
+        auto result = measure(scenario, rounds);
+        auto p99 = result.percentile(0.99);
+        auto bytes_per_key = result.perKey(double(result.bytes));
+        auto syscalls_per_key = result.perKey(double(result.syscalls));
+        std::cout << separator << "\n  {\"name\": \"" << result.name << "\""
+                  << ", \"keys\": " << result.latencies.size()
+                  << ", \"p50_us\": " << result.percentile(0.50)
+                  << ", \"p99_us\": " << p99
+                  << ", \"bytes_per_key\": " << bytes_per_key
+                  << ", \"syscalls_per_key\": " << syscalls_per_key << "}";
+        separator = ",";
+
+        failed |= max_p99_us > 0 && p99 > max_p99_us;
+        failed |= max_bytes_per_key > 0 && bytes_per_key > max_bytes_per_key;
+        failed |= max_syscalls_per_key > 0 && syscalls_per_key > max_syscalls_per_key;
+    }
+    std::cout << "\n], \"passed\": " << (failed ? "false" : "true") << "}" << std::endl;
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <cmdly/line.h>
+
+using namespace cmdly;
+
+// Words in one style and the spaces between them in another, the simplest lexer there is
+class WordHighlighter : public Highlighter
+{
+public:
+    std::uint32_t word = addStyle(TextStyle(Color::Blue));
+
+    Token next(std::string_view text, State state) override
+    {
+        auto length = text[0] == ' ' ? text.find_first_not_of(' ') : text.find(' ');
+        return {std::min(length, text.size()), text[0] == ' ' ? CONTENT_STYLE : word, state};
+    }
+}; /* End of class WordHighlighter */
+
+// Usage: line_edit_benchmark [edits per length]
+//
+// Cost of typing and deleting in the middle of lines of growing length (a pasted JSON payload is
+// easily 100 KB), next to the same edits done on a plain std::string that shifts the tail each time
+// and on a line lexed by a highlighter.
+
+template<typename Edit>
+static double nanosecondsPerEdit(std::size_t edits, Edit edit)
+{
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < edits; ++i)
+    {
+        edit(i);
+    }
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - begin);
+    return elapsed.count() / double(edits);
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t edits = argc > 1 ? std::stoul(argv[1]) : 100000;
+
+    for (std::size_t length : {1000, 10000, 100000, 1000000})
+    {
+        const std::string payload(length, 'x');
+
+        // the cursor stays in the middle, every edit types a character there and every other one
+        // deletes it again, like typing with corrections
+        Line line;
+        line.append(payload);
+        auto middle = int(length / 2);
+        auto line_ns = nanosecondsPerEdit(edits, [&line, middle](std::size_t i) {
+            if (i % 2 == 0)
+            {
+                line.insert(middle, 'y');
+            }
+            else
+            {
+                line.remove(middle);
+            }
+        });
+
+        // words of 7 characters, the highlighter lexes again the ones around the edit only
+        std::string words;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            words += i % 8 == 7 ? ' ' : 'x';
+        }
+        Line highlighted;
+        highlighted.setHighlighter(std::make_shared<WordHighlighter>());
+        highlighted.append(words);
+        auto highlighted_ns = nanosecondsPerEdit(edits, [&highlighted, middle](std::size_t i) {
+            if (i % 2 == 0)
+            {
+                highlighted.insert(middle, 'y');
+            }
+            else
+            {
+                highlighted.remove(middle);
+            }
+        });
+
+        std::string text = payload;
+        auto string_ns = nanosecondsPerEdit(edits, [&text, middle](std::size_t i) {
+            if (i % 2 == 0)
+            {
+                text.insert(text.begin() + middle, 'y');
+            }
+            else
+            {
+                text.erase(text.begin() + middle);
+            }
+        });
+
+        // jumping between both ends moves the gap over half of the line every time
+        auto jump_ns = nanosecondsPerEdit(edits / 100, [&line, length](std::size_t i) {
+            line.insert(i % 2 == 0 ? 0 : int(length), 'y');
+            line.remove(i % 2 == 0 ? 0 : int(length));
+        });
+
+        std::cout << "length=" << length
+                  << " line_ns/edit=" << line_ns
+                  << " string_ns/edit=" << string_ns
+                  << " highlighted_ns/edit=" << highlighted_ns
+                  << " line_jump_ns/edit=" << jump_ns
+                  << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <chrono>
+#include <iostream>
+#include <cmdly/io.h>
+#include "helpers/pty.h"
+
+using namespace cmdly;
+
+static void report(const std::string &name, const IO::Statistics &stats, std::chrono::nanoseconds elapsed,
+                   std::size_t keys)
+{
+    auto per_key = [keys](std::uint64_t v) { return double(v) / double(keys); };
+    std::cout << name << ":"
+              << " reads/key=" << per_key(stats.reads)
+              << " termios/key=" << per_key(stats.termios_calls)
+              << " syscalls/key=" << per_key(stats.reads + stats.termios_calls)
+              << " ns/key=" << per_key(elapsed.count())
+              << std::endl;
+}
+
+template<typename Fn>
+static void measure(const std::string &name, std::size_t keys, Fn &&fn)
+{
+    PseudoTerminal pty;
+    StandardIO io(pty.slave(), pty.slave());
+
+    auto begin = std::chrono::steady_clock::now();
+    fn(pty, io);
+    auto elapsed = std::chrono::steady_clock::now() - begin;
+
+    report(name, io.statistics(), std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed), keys);
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t keys = argc > 1 ? std::stoul(argv[1]) : 10000;
+
+    // every getKey() opens and closes its own raw mode session
+    measure("per-key session", keys, [keys](PseudoTerminal &pty, StandardIO &io) {
+        for (std::size_t i = 0; i < keys; ++i)
+        {
+            pty.send("a");
+            io.getKey();
+        }
+    });
+
+    // one raw mode session held for the whole run, as Terminal does
+    measure("persistent session", keys, [keys](PseudoTerminal &pty, StandardIO &io) {
+        RawMode raw_mode(io);
+        for (std::size_t i = 0; i < keys; ++i)
+        {
+            pty.send("a");
+            io.getKey();
+        }
+    });
+
+    return 0;
+}
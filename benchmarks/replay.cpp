@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <cmdly/recording.h>
+#include <cmdly/terminal.h>
+
+using namespace cmdly;
+
+// Usage: replay <session.log> [--original-speed] [--events]
+//
+// Replays a session recorded with RecordingIO and reports how long every key took to process
+// and how much output it produced.
+
+static double micros(std::chrono::nanoseconds ns)
+{
+    return double(ns.count()) / 1000.0;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        std::cerr << "usage: " << argv[0] << " <session.log> [--original-speed] [--events]" << std::endl;
+        return 2;
+    }
+
+    auto speed = ReplayIO::Speed::Fastest;
+    bool show_events = false;
+    for (int i = 2; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--original-speed") == 0) { speed = ReplayIO::Speed::Original; }
+        if (std::strcmp(argv[i], "--events") == 0) { show_events = true; }
+    }
+
+    auto io = std::make_shared<ReplayIO>(argv[1], speed);
+    Terminal terminal(io);
+    terminal.run("> ");
+
+    auto timings = io->timings();
+    if (timings.empty())
+    {
+        std::cout << "no input in session" << std::endl;
+        return 0;
+    }
+
+    std::size_t recorded_output = 0;
+    for (auto &event : io->events())
+    {
+        if (event.type == SessionEvent::Type::Output)
+        {
+            recorded_output += event.data.size();
+        }
+    }
+
+    std::size_t output = 0;
+    std::chrono::nanoseconds total(0);
+    if (show_events)
+    {
+        std::cout << "event  time[ms]  processing[us]  output[B]" << std::endl;
+    }
+    for (auto &timing : timings)
+    {
+        output += timing.output_bytes;
+        total += timing.processing;
+        if (show_events)
+        {
+            std::cout << std::setw(5) << timing.event
+                      << std::setw(10) << std::fixed << std::setprecision(1) << micros(timing.time) / 1000.0
+                      << std::setw(16) << std::setprecision(2) << micros(timing.processing)
+                      << std::setw(11) << timing.output_bytes << std::endl;
+        }
+    }
+
+    std::sort(timings.begin(), timings.end(), [](auto &a, auto &b) { return a.processing < b.processing; });
+    auto percentile = [&timings](double p) { return micros(timings[std::size_t(p * double(timings.size() - 1))].processing); };
+    std::cout << std::setprecision(2)
+              << "keys=" << timings.size()
+              << " total_us=" << micros(total)
+              << " p50_us=" << percentile(0.50)
+              << " p99_us=" << percentile(0.99)
+              << " max_us=" << micros(timings.back().processing)
+              << " output_bytes=" << output
+              << " recorded_output_bytes=" << recorded_output
+              << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cmdly/server.h>
+
+using namespace cmdly;
+
+// Usage: session_load [idle sessions] [active clients] [commands per client] [worker threads]
+//
+// Runs a SessionServer in this process, opens many idle sessions to see what one costs, then
+// measures command round-trips on a few active ones while the idle sessions stay connected.
+
+static std::size_t residentKilobytes()
+{
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0, resident = 0;
+    statm >> size >> resident;
+    return resident * std::size_t(::sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+static int connectTo(const std::string &path)
+{
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    struct sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        throw IOError("could not connect to " + path);
+    }
+    return fd;
+}
+
+static void readUntil(int fd, std::string_view text)
+{
+    std::string output;
+    struct pollfd pfd = {fd, POLLIN, 0};
+    while (output.find(text) == std::string::npos)
+    {
+        char buf[4096];
+        if (::poll(&pfd, 1, 5000) <= 0 || (pfd.revents & POLLIN) == 0)
+        {
+            throw IOError("session did not answer");
+        }
+        auto len = ::read(fd, buf, sizeof(buf));
+        if (len <= 0)
+        {
+            throw IOError("session closed");
+        }
+        output.append(buf, len);
+    }
+}
+
+static void raiseDescriptorLimit()
+{
+    struct rlimit limit{};
+    ::getrlimit(RLIMIT_NOFILE, &limit);
+    limit.rlim_cur = limit.rlim_max;
+    ::setrlimit(RLIMIT_NOFILE, &limit);
+}
+
+int main(int argc, char *argv[])
+{
+    const std::size_t idle = argc > 1 ? std::stoul(argv[1]) : 2000;
+    const std::size_t active = argc > 2 ? std::stoul(argv[2]) : 8;
+    const std::size_t commands = argc > 3 ? std::stoul(argv[3]) : 1000;
+    SessionServer::Options options;
+    options.threads = argc > 4 ? std::stoul(argv[4]) : 2;
+
+    raiseDescriptorLimit();
+    std::string path = "/tmp/cmdly_session_load_" + std::to_string(::getpid()) + ".sock";
+    SessionServer server(path, [](Terminal &terminal) {
+        terminal.onLineEntered([](const std::string &line, Terminal &terminal) {
+            if (line == "status")
+            {
+                terminal.writeText("ok\n");
+                return LineEnteredListener::Status::CONTINUE;
+            }
+            return LineEnteredListener::Status::OK;
+        });
+    }, options);
+    server.start();
+
+    // idle sessions: memory per session (client sockets are counted too, they live in this process)
+    auto rss_before = residentKilobytes();
+    std::vector<int> idle_fds;
+    for (std::size_t i = 0; i < idle; ++i)
+    {
+        idle_fds.push_back(connectTo(path));
+        readUntil(idle_fds.back(), "> ");
+    }
+    auto rss_per_session = idle ? double(residentKilobytes() - rss_before) / double(idle) : 0.0;
+
+    // active sessions: every client sends a command and waits for its answer, round after round
+    std::vector<std::vector<std::chrono::nanoseconds>> latencies(active);
+    auto begin = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (std::size_t c = 0; c < active; ++c)
+    {
+        clients.emplace_back([&path, &latencies, c, commands]() {
+            int fd = connectTo(path);
+            readUntil(fd, "> ");
+            for (std::size_t i = 0; i < commands; ++i)
+            {
+                auto sent = std::chrono::steady_clock::now();
+                if (::write(fd, "status\r", 7) != 7)
+                {
+                    throw IOError("could not send command");
+                }
+                readUntil(fd, "ok\n");
+                latencies[c].push_back(std::chrono::steady_clock::now() - sent);
+            }
+            ::close(fd);
+        });
+    }
+    for (auto &client : clients)
+    {
+        client.join();
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin);
+
+    std::vector<std::chrono::nanoseconds> all;
+    for (auto &client_latencies : latencies)
+    {
+        all.insert(all.end(), client_latencies.begin(), client_latencies.end());
+    }
+    std::sort(all.begin(), all.end());
+    auto percentile = [&all](double p) {
+        return all.empty() ? 0.0 : double(all[std::size_t(p * double(all.size() - 1))].count()) / 1000.0;
+    };
+
+    std::cout << "sessions=" << server.sessions()
+              << " threads=" << options.threads
+              << " rss_kb/session=" << rss_per_session
+              << " commands/s=" << std::size_t(double(all.size()) / elapsed.count())
+              << " p50_us=" << percentile(0.50)
+              << " p99_us=" << percentile(0.99)
+              << std::endl;
+
+    for (int fd : idle_fds)
+    {
+        ::close(fd);
+    }
+    server.stop();
+    return 0;
+}
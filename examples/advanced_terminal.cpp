@@ -4,16 +4,59 @@
 
 #include <memory>
 #include <iostream>
+#include <cmdly/recording.h>
 #include <cmdly/terminal.h>
 
 using namespace cmdly;
 
-int main()
+// The command in green (red when unknown), options in cyan and quoted text in yellow
+class CommandHighlighter : public Highlighter
+{
+public:
+    enum : State { COMMAND, ARGUMENTS };
+
+    CommandHighlighter() :
+        known_(addStyle(TextStyle(Color::Green))),
+        unknown_(addStyle(TextStyle(Color::Red))),
+        option_(addStyle(TextStyle(Color::Cyan))),
+        quoted_(addStyle(TextStyle(Color::Yellow)))
+    {}
+
+    Token next(std::string_view text, State state) override
+    {
+        if (text[0] == ' ')
+        {
+            auto end = text.find_first_not_of(' ');
+            return {end == std::string_view::npos ? text.size() : end, CONTENT_STYLE, state};
+        }
+        if (text[0] == '"')
+        {
+            auto end = text.find('"', 1);
+            return {end == std::string_view::npos ? text.size() : end + 1, quoted_, ARGUMENTS};
+        }
+        auto word = text.substr(0, text.find(' '));
+        if (state == COMMAND)
+        {
+            return {word.size(), word == "help" || word == "exit" ? known_ : unknown_, ARGUMENTS};
+        }
+        return {word.size(), word[0] == '-' ? option_ : CONTENT_STYLE, ARGUMENTS};
+    }
+
+private:
+    std::uint32_t known_, unknown_, option_, quoted_;
+}; /* End of class CommandHighlighter */
+
+int main(int argc, char *argv[])
 {
     std::cout << "Welcome to Advanced Console!" << std::endl;
     std::cout << "To quit type \"exit\" or press <CTRL+C>" << std::endl;
 
-    auto io = std::make_shared<StandardIO>();
+    // "advanced_terminal session.log" records the session, benchmarks/replay plays it back
+    std::shared_ptr<IO> io = std::make_shared<StandardIO>();
+    if (argc > 1)
+    {
+        io = std::make_shared<RecordingIO>(io, argv[1]);
+    }
     auto history = std::make_shared<MemoryHistory>();
     auto completion = std::make_shared<Completion>();
     auto terminal = std::make_unique<Terminal>(io, history, completion);
@@ -28,36 +71,14 @@ int main()
         return KeyPressedListener::Status::CONTINUE;
     });
 
-    terminal->onLineEntered([](const std::string &line, Terminal &terminal) {
-        if (line == "help")
-        {
-            terminal.writeText("Allowed commands:\n");
-            terminal.writeText("  help - show this help\n");
-            terminal.writeText("  exit - quit terminal\n ");
-            return LineEnteredListener::Status::CONTINUE;
-        }
-        return LineEnteredListener::Status::OK;
+    terminal->commands()->command("help").handle([](const CommandTree::Invocation &, Terminal &terminal) {
+        terminal.writeText("Allowed commands:\n");
+        terminal.writeText("  help - show this help\n");
+        terminal.writeText("  exit - quit terminal\n ");
+        return LineEnteredListener::Status::CONTINUE;
     });
-    completion->insert("help");
 
-    terminal->onLineChanged([](const std::string &content, Line &line, Cursor &, Terminal &) {
-        if (content == "red")
-        {
-            line.setContentStyle(TextStyle(Color::Red));
-            line.update();
-        }
-        else if (content == "blue")
-        {
-            line.setContentStyle(TextStyle(Color::Blue));
-            line.update();
-        }
-        else if (content == "green")
-        {
-            line.setContentStyle(TextStyle(Color::Green));
-            line.update();
-        }
-        return LineChangedListener::Status::OK;
-    });
+    terminal->setHighlighter(std::make_shared<CommandHighlighter>());
 
     terminal->run("console> ");
     terminal->resetStyle();
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <memory>
+#include <iostream>
+#include <cmdly/terminal.h>
+
+using namespace cmdly;
+
+static Task<> console(Terminal &terminal)
+{
+    for (;;)
+    {
+        auto line = co_await terminal.readLineAsync("console> ");
+        if (line == "exit")
+        {
+            break;
+        }
+        if (line == "confirm")
+        {
+            terminal.writeText("Are you sure? [y/n]\n");
+            auto key = co_await terminal.nextKeyAsync();
+            terminal.writeText(key == Key('y') ? "confirmed\n" : "cancelled\n");
+            continue;
+        }
+        terminal.writeText("line=" + line + "\n");
+    }
+    terminal.stop();
+}
+
+static Task<> heartbeat(Executor &executor, Terminal &terminal)
+{
+    while (terminal.isRunning())
+    {
+        co_await executor.sleep(std::chrono::seconds(1));
+    }
+}
+
+int main()
+{
+    std::cout << "Welcome to Coroutine Console!" << std::endl;
+    std::cout << "To quit type \"exit\" or press <CTRL+C>" << std::endl;
+
+    Executor executor;
+    Terminal terminal;
+
+    executor.spawn(console(terminal));
+    executor.spawn(heartbeat(executor, terminal));
+    executor.run();
+
+    return 0;
+}
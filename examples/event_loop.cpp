@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <memory>
+#include <iostream>
+#include <cmdly/terminal.h>
+
+using namespace cmdly;
+
+int main()
+{
+    std::cout << "Welcome to Event Loop Console!" << std::endl;
+    std::cout << "The console stays responsive while the application serves its own events" << std::endl;
+    std::cout << "To quit type \"exit\" or press <CTRL+C>" << std::endl;
+
+    auto terminal = std::make_unique<Terminal>();
+    std::uint32_t ticks = 0;
+
+    terminal->onLineEntered([&ticks](const std::string &line, Terminal &terminal) {
+        if (line == "ticks")
+        {
+            terminal.writeText(string::format("{} ticks so far\n", ticks));
+            return LineEnteredListener::Status::CONTINUE;
+        }
+        return LineEnteredListener::Status::OK;
+    });
+
+    // application timer served by the same thread as the keyboard
+    terminal->reactor()->addTimer(std::chrono::seconds(1), std::chrono::seconds(1), [&ticks]() {
+        ticks++;
+    });
+
+    terminal->start("console> ");
+    while (terminal->pollOnce())
+    {}
+
+    return 0;
+}
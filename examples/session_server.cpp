@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <csignal>
+#include <iostream>
+#include <cmdly/server.h>
+
+using namespace cmdly;
+
+// Connect with: socat -,raw,echo=0 UNIX-CONNECT:/tmp/cmdly.sock
+int main(int argc, char *argv[])
+{
+    std::string path = argc > 1 ? argv[1] : "/tmp/cmdly.sock";
+
+    SessionServer server(path, [](Terminal &terminal) {
+        terminal.writeText("Welcome to Session Server!\n");
+        terminal.onLineEntered([](const std::string &line, Terminal &terminal) {
+            if (line == "help")
+            {
+                terminal.writeText("Allowed commands:\n");
+                terminal.writeText("  help - show this help\n");
+                terminal.writeText("  exit - close the session\n");
+                return LineEnteredListener::Status::CONTINUE;
+            }
+            return LineEnteredListener::Status::OK;
+        });
+        terminal.completion()->insert("help");
+    });
+
+    // blocked before the workers start, so only sigwait() below gets them
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    server.start();
+    std::cout << "Listening on " << path << ", press <CTRL+C> to quit" << std::endl;
+    int signal = 0;
+    sigwait(&signals, &signal);
+
+    server.stop();
+    return 0;
+}
@@ -14,6 +14,7 @@ int main()
     std::cout << "To quit press <CTRL+C>" << std::endl;
 
     auto io = std::make_unique<StandardIO>();
+    RawMode raw_mode(*io);
 
     for (;;)
     {
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_COMMAND_H
+#define CMDLY_COMMAND_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cmdly/listener.h>
+
+namespace cmdly {
+
+// Declared commands: a command has subcommands and typed arguments, e.g. "bucket create <name>
+// [<size>]". Every command keeps its subcommands in a hash table, so an entered line gets to its
+// handler with one lookup per word whatever the number of commands, and the same tree tells the
+// completion what may come at the cursor.
+class CommandTree : public LineEnteredListener
+{
+public:
+    // Word of an entered line, offsets are those of the line (quotes included)
+    struct Token
+    {
+        std::string text;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    // Values for an argument starting with the given prefix
+    using Completer = std::function<std::vector<std::string>(std::string_view prefix)>;
+
+    struct Argument
+    {
+        enum class Type
+        {
+            String,
+            Integer,
+            Choice
+        };
+
+        std::string name;
+        Type type;
+        bool optional;
+        std::vector<std::string> choices;
+        Completer completer;
+
+        [[nodiscard]] bool accepts(std::string_view value) const;
+        [[nodiscard]] std::vector<std::string> complete(std::string_view prefix) const;
+    };
+
+    // The entered command with its arguments by name
+    class Invocation
+    {
+    public:
+        // Words naming the command, e.g. {"bucket", "create"}
+        [[nodiscard]] const std::vector<std::string> &path() const
+        {
+            return path_;
+        }
+
+        [[nodiscard]] bool has(std::string_view name) const;
+        // Throws std::out_of_range when the argument was not given
+        [[nodiscard]] const std::string &get(std::string_view name) const;
+        [[nodiscard]] std::int64_t integer(std::string_view name) const;
+
+    private:
+        friend class CommandTree;
+        std::vector<std::string> path_;
+        std::vector<std::pair<std::string, std::string>> arguments_;
+    }; /* End of class Invocation */
+
+    using Handler = std::function<LineEnteredListener::Status(const Invocation &, Terminal &)>;
+
+    class Command
+    {
+    public:
+        explicit Command(std::string path) :
+            path_(std::move(path))
+        {}
+
+        // The subcommand, added when there is none of that name
+        Command &command(const std::string &name);
+        // Arguments come after the subcommands, in the order they are added; the optional ones last
+        Command &argument(const std::string &name, Argument::Type type = Argument::Type::String, bool optional = false);
+        Command &choice(const std::string &name, std::vector<std::string> choices, bool optional = false);
+        // Completes the values of the argument added last
+        Command &complete(Completer completer);
+        Command &handle(Handler handler);
+        // Leaves the command out of completion, e.g. the ones every terminal has built in
+        Command &hide();
+
+        [[nodiscard]] const Command *find(const std::string &name) const;
+        [[nodiscard]] const std::string &path() const
+        {
+            return path_;
+        }
+        // e.g. "usage: bucket create <name> [<size>]"
+        [[nodiscard]] std::string usage() const;
+
+    private:
+        friend class CommandTree;
+        std::string path_;
+        std::unordered_map<std::string, std::unique_ptr<Command>> commands_;
+        std::vector<Argument> arguments_;
+        Handler handler_;
+        bool hidden_{false};
+    }; /* End of class Command */
+
+    CommandTree() :
+        root_("")
+    {}
+
+    // A top level command
+    Command &command(const std::string &name)
+    {
+        return root_.command(name);
+    }
+
+    // Names of the top level commands
+    [[nodiscard]] std::vector<std::string> names() const;
+
+    // Runs the handler of the entered command. A line not starting with a command, or with words
+    // after a command taking no arguments, is left to the listeners after this one; a command
+    // entered wrong gets its usage written.
+    Status invoke(const std::string &content, Terminal &terminal) override;
+
+    // Candidates for the word following words, starting with prefix and in order: the subcommands
+    // that are not hidden and the values of the argument due there. False when the words are not a
+    // known command.
+    bool complete(const std::vector<std::string> &words, std::string_view prefix, std::vector<std::string> &candidates) const;
+
+    // Splits a line at spaces, a word in double quotes may have spaces in it
+    static std::vector<Token> tokenize(std::string_view text);
+
+private:
+    Command root_;
+}; /* End of class CommandTree */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_COMMAND_H */
@@ -5,15 +5,98 @@
 #ifndef CMDLY_COMPLETION_H
 #define CMDLY_COMPLETION_H
 
-#include <set>
+#include <algorithm>
 #include <cstdint>
+#include <string>
+#include <string_view>
 #include <utility>
+#include <vector>
+#include <cmdly/command.h>
+#include <cmdly/fuzzy.h>
 #include <cmdly/listener.h>
+#include <cmdly/radix_tree.h>
+#include <cmdly/screen.h>
 
 namespace cmdly {
 
 class Terminal;
 
+// Completion words in a radix tree, a node either ends a word or branches. Finding the words for a
+// phrase walks the phrase and then just the words found, and the path to the node reached is their
+// longest common prefix.
+class CompletionIndex
+{
+public:
+    static constexpr std::size_t NONE = RadixTree<bool>::NONE;
+
+    // Returns false when the word is there already
+    bool insert(std::string_view word)
+    {
+        std::vector<std::size_t> path;
+        tree_.insert(word, path, [](bool) { return false; });
+        auto &end = tree_[path.back()];
+        if (end)
+        {
+            return false;
+        }
+        end = true;
+        size_++;
+        return true;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return size_;
+    }
+
+    void clear()
+    {
+        tree_.clear();
+        size_ = 0;
+    }
+
+    // The node below which are all the words starting with phrase, NONE when there are none; prefix
+    // gets the longest prefix they share
+    std::size_t find(std::string_view phrase, std::string &prefix) const
+    {
+        std::size_t depth;
+        auto node = tree_.descend(phrase, depth);
+        if (node == NONE)
+        {
+            prefix.clear();
+            return NONE;
+        }
+        // a phrase ending inside an edge gets the rest of it
+        auto &label = tree_.label(node);
+        prefix.assign(phrase);
+        prefix.append(label, label.size() - (depth - phrase.size()));
+        // only the root may neither end a word nor branch
+        while (!tree_[node] && tree_.children(node).size() == 1)
+        {
+            node = tree_.children(node).front();
+            prefix += tree_.label(node);
+        }
+        return node;
+    }
+
+    // Calls visit(word) for the words below the node in order, prefix being the path to it
+    template<typename Visit>
+    void visit(std::size_t node, std::string &prefix, Visit &&visit) const
+    {
+        tree_.visit(node, prefix, [this, &visit](std::size_t next, const std::string &word) {
+            if (tree_[next])
+            {
+                visit(word);
+            }
+        });
+    }
+
+private:
+    // whether a word ends at the node
+    RadixTree<bool> tree_;
+    std::size_t size_{0};
+}; /* End of class CompletionIndex */
+
 class Completion : public KeyPressedListener
 {
 public:
@@ -48,18 +131,70 @@ public:
         }
     }; /* End of SearchResult */
 
+    // Words starting with the phrase, or words with the characters of the phrase in order anywhere
+    // in them, ranked by how well they match
+    enum class Matching
+    {
+        Prefix,
+        Fuzzy
+    };
+
+    // Rows of candidates the menu shows at most, it scrolls through the rest
+    static constexpr std::size_t MENU_ROWS = 8;
+    // Best fuzzy matches given by default
+    static constexpr std::size_t FUZZY_LIMIT = 64;
+
     Completion();
     void insert(const std::string &word);
     void insert(std::initializer_list<std::string> words);
     std::shared_ptr<Completion::SearchResult> search(const std::string &phrase);
     Completion::Status invoke(const Key &key, Line &line, Cursor &, Terminal &terminal) override;
 
+    void setMatching(Matching matching);
+    [[nodiscard]] Matching matching() const;
+    // Fuzzy search gives limit best matches only, scanning large vocabularies with up to threads
+    // threads (0 for as many as the hardware runs at once)
+    void setFuzzyLimit(std::size_t limit);
+    void setFuzzyThreads(std::size_t threads);
+    // Words after a command are completed with what the command takes there, the first word with the
+    // names of the commands too
+    void setCommands(const std::shared_ptr<CommandTree> &commands);
+
+    // The menu of candidates below the line, Tab and the arrows move the selection in it and Enter
+    // takes the selected one
+    [[nodiscard]] bool isMenuOpen() const;
+    void closeMenu(Terminal &terminal);
+
 protected:
-    std::set<std::string> words_;
+    CompletionIndex words_;
     std::uint16_t key_tab_counter_;
     std::uint16_t longest_word_length_;
+    // words again, kept for fuzzy matching only
+    FuzzyMatcher fuzzy_;
+    Matching matching_;
+    std::size_t fuzzy_limit_;
+    std::size_t fuzzy_threads_;
+    std::shared_ptr<CommandTree> commands_;
+    // menu drawn through a cell grid, so moving the selection writes only the cells that changed
+    std::shared_ptr<SearchResult> menu_result_;
+    // content in [menu_begin_, menu_end_) is replaced with the candidate taken
+    std::size_t menu_begin_;
+    std::size_t menu_end_;
+    CellGrid menu_;
+    CellGrid::StyleIndex selected_style_;
+    std::size_t selected_;
+    std::size_t menu_columns_;
+    std::size_t column_width_;
+    std::size_t first_row_;
 
-    static void showSearchResult(Terminal &terminal, std::shared_ptr<Completion::SearchResult>& result);
+    std::shared_ptr<Completion::SearchResult> searchFuzzy(const std::string &phrase);
+    std::shared_ptr<Completion::SearchResult> searchCommands(const std::string &content, std::size_t at,
+                                                             std::size_t &begin, std::size_t &end);
+    static std::size_t replace(Line &line, std::size_t begin, std::size_t end, const std::string &text);
+    void openMenu(Line &line, Terminal &terminal);
+    void drawMenu(Terminal &terminal);
+    void select(std::size_t index, Terminal &terminal);
+    Completion::Status navigateMenu(const Key &key, Line &line, Cursor &cursor, Terminal &terminal);
 }; /* End of Completion */
 
 } /* End of namespace cmdly */
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_COROUTINE_H
+#define CMDLY_COROUTINE_H
+
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <list>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <cmdly/exception.h>
+#include <cmdly/reactor.h>
+
+namespace cmdly {
+
+template<typename T = void>
+class Task;
+
+namespace detail {
+
+struct TaskPromiseBase
+{
+    std::coroutine_handle<> continuation{std::noop_coroutine()};
+    std::exception_ptr exception;
+
+    struct FinalAwaiter
+    {
+        [[nodiscard]] bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        template<typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        {
+            return handle.promise().continuation;
+        }
+
+        void await_resume() const noexcept
+        {}
+    }; /* End of struct FinalAwaiter */
+
+    std::suspend_always initial_suspend() const noexcept
+    {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept
+    {
+        return {};
+    }
+
+    void unhandled_exception()
+    {
+        exception = std::current_exception();
+    }
+}; /* End of struct TaskPromiseBase */
+
+template<typename T>
+struct TaskPromise : TaskPromiseBase
+{
+    std::optional<T> value;
+
+    Task<T> get_return_object();
+
+    void return_value(T v)
+    {
+        value.emplace(std::move(v));
+    }
+
+    T result()
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+        return std::move(*value);
+    }
+}; /* End of struct TaskPromise */
+
+template<>
+struct TaskPromise<void> : TaskPromiseBase
+{
+    Task<void> get_return_object();
+
+    void return_void() const
+    {}
+
+    void result() const
+    {
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+}; /* End of struct TaskPromise<void> */
+
+} /* End of namespace detail */
+
+// Lazily started coroutine, it runs when awaited or spawned on an Executor
+template<typename T>
+class Task
+{
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) :
+        handle_(handle)
+    {}
+
+    Task(Task &&other) noexcept :
+        handle_(std::exchange(other.handle_, nullptr))
+    {}
+
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            destroy();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task()
+    {
+        destroy();
+    }
+
+    [[nodiscard]] bool done() const
+    {
+        return !handle_ || handle_.done();
+    }
+
+    [[nodiscard]] std::coroutine_handle<> handle() const
+    {
+        return handle_;
+    }
+
+    T result()
+    {
+        return handle_.promise().result();
+    }
+
+    [[nodiscard]] bool await_ready() const
+    {
+        return done();
+    }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting)
+    {
+        handle_.promise().continuation = awaiting;
+        return handle_;
+    }
+
+    T await_resume()
+    {
+        return result();
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+
+    void destroy()
+    {
+        if (handle_)
+        {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+}; /* End of class Task */
+
+namespace detail {
+
+template<typename T>
+Task<T> TaskPromise<T>::get_return_object()
+{
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object()
+{
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+} /* End of namespace detail */
+
+// Single-threaded executor resuming coroutines and serving the reactor in between
+class Executor
+{
+public:
+    explicit Executor(const std::shared_ptr<Reactor> &reactor = std::make_shared<Reactor>());
+
+    Executor(const Executor &) = delete;
+    Executor &operator=(const Executor &) = delete;
+
+    // Executor running on the calling thread, if any
+    static Executor *current();
+
+    const std::shared_ptr<Reactor> &reactor();
+
+    void spawn(Task<void> task);
+    void post(std::function<void()> callback);
+    void schedule(std::coroutine_handle<> handle);
+
+    // Runs until all spawned tasks are done or stop() is called
+    void run();
+    void stop();
+
+    class SleepAwaiter
+    {
+    public:
+        SleepAwaiter(Executor &executor, std::chrono::milliseconds duration) :
+            executor_(executor), duration_(duration)
+        {}
+
+        [[nodiscard]] bool await_ready() const
+        {
+            return duration_.count() <= 0;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        void await_resume() const
+        {}
+
+    private:
+        Executor &executor_;
+        std::chrono::milliseconds duration_;
+    }; /* End of class SleepAwaiter */
+
+    SleepAwaiter sleep(std::chrono::milliseconds duration);
+
+private:
+    std::shared_ptr<Reactor> reactor_;
+    std::deque<std::function<void()>> ready_;
+    std::list<Task<void>> tasks_;
+    bool stopped_{false};
+
+    void collectFinishedTasks();
+}; /* End of class Executor */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_COROUTINE_H */
@@ -5,7 +5,10 @@
 #ifndef CMDLY_CURSOR_H
 #define CMDLY_CURSOR_H
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
 #include <memory>
 #include <cmdly/exception.h>
 #include <cmdly/line.h>
@@ -17,10 +20,8 @@ class Cursor
 {
 public:
     explicit Cursor(Line &line, const std::shared_ptr<IO> &io) :
-        line_(line), io_(io), row_(0), col_(0)
+        line_(line), io_(io), row_(0), index_(line_.prompt().length())
     {
-        readPosition();
-        col_ = line_.prompt().length() + 1;
         updatePosition();
     }
 
@@ -29,92 +30,141 @@ public:
         return row_;
     }
 
+    // Screen column (1-based) of the cursor, wide characters count twice
     [[nodiscard]] std::uint32_t col() const
     {
-        return col_;
+        return std::uint32_t(line_.columnAt(index_) + 1);
+    }
+
+    // Byte offset in the line the cursor is at, always on a character boundary
+    [[nodiscard]] std::size_t index() const
+    {
+        return index_;
     }
 
     void moveLeft()
     {
-        if (col_ > (line_.prompt().length() + 1))
+        if (index_ > line_.prompt().length())
         {
-            col_--;
+            index_ = std::max(line_.prevBoundary(index_), line_.prompt().length());
             updatePosition();
         }
     }
 
     void moveRight()
     {
-        if (col_ <= line_.length())
+        if (index_ < line_.length())
         {
-            col_++;
+            index_ = line_.nextBoundary(index_);
             updatePosition();
         }
     }
 
     void moveToHome()
     {
-        col_ = line_.prompt().length() + 1;
+        index_ = line_.prompt().length();
         updatePosition();
     }
 
     void moveToEnd()
     {
-        col_ = line_.length() + 1;
+        index_ = line_.length();
+        updatePosition();
+    }
+
+    // Moves to the byte offset in the line, kept after the prompt
+    void moveTo(std::size_t index)
+    {
+        index_ = std::clamp(index, line_.prompt().length(), line_.length());
         updatePosition();
     }
 
     void putChar(char c)
     {
-        line_.insert(int(col_ - 1), c);
+        line_.insert(int(index_), c);
+        line_.update();
+        index_++;
+        updatePosition();
+    }
+
+    // Inserts the whole text with a single redraw
+    void putText(const std::string &text)
+    {
+        if (text.empty())
+        {
+            return;
+        }
+        line_.insert(int(index_), text);
         line_.update();
-        col_++;
+        index_ += text.size();
         updatePosition();
     }
 
+    // Removes the whole character before the cursor, with its combining marks
     void eatChar()
     {
-        if (col_ > (line_.prompt().length() + 1))
+        if (index_ > line_.prompt().length())
         {
-            line_.remove(int(col_ - 2));
+            auto begin = std::max(line_.prevBoundary(index_), line_.prompt().length());
+            line_.erase(begin, index_ - begin);
             line_.update();
-            col_--;
+            index_ = begin;
             updatePosition();
         }
     }
 
-private:
-    Line &line_;
-    std::shared_ptr<IO> io_;
-    std::uint32_t row_;
-    std::uint32_t col_;
+    // Puts the terminal cursor where it should be, e.g. after the line was redrawn by a listener
+    void sync()
+    {
+        if (line_.screenColumn() != col())
+        {
+            updatePosition();
+        }
+    }
 
-    void readPosition()
+    // Asks the terminal for the cursor position (one round-trip), false when it did not answer in time
+    bool queryPosition(std::chrono::milliseconds timeout = std::chrono::milliseconds(500))
     {
         *io_ << "\033[6n";
-        ::fflush(stdout);
+        io_->flush();
         char data[32] = {0};
         for (std::size_t i = 0; i < sizeof(data) - 1; ++i)
         {
-            data[i] = io_->getChar();
-            if (data[i] < 0)
+            if (!io_->waitForInput(timeout))
             {
                 break;
             }
-            if (data[i] == 'R')
+            data[i] = io_->getChar();
+            if (data[i] < 0 || data[i] == 'R')
             {
                 break;
             }
         }
-        if (::sscanf(data, "\033[%u;%uR", &row_, &col_) != 2)
+
+        std::uint32_t row = 0;
+        std::uint32_t col = 0;
+        if (::sscanf(data, "\033[%u;%uR", &row, &col) != 2)
         {
-            throw CursorError("could not read position");
+            // the fallback is a full redraw on the next move
+            line_.invalidate();
+            return false;
         }
+        row_ = row;
+        line_.setScreenColumn(col);
+        return true;
     }
 
+private:
+    Line &line_;
+    std::shared_ptr<IO> io_;
+    std::uint32_t row_;
+    std::size_t index_;
+
     void updatePosition()
     {
-        *io_ << "\033[" << row_ << ";" << col_ << "H";
+        // the line may have been changed by a listener since
+        index_ = std::min(index_, line_.length());
+        line_.moveCursor(col());
     }
 }; /* End of class Cursor */
 
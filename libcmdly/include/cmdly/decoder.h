@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_DECODER_H
+#define CMDLY_DECODER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <cmdly/key.h>
+
+namespace cmdly {
+
+// Incremental decoder splitting a stream of input bytes into keys
+class KeyDecoder
+{
+public:
+    static constexpr char ESC = '\033';
+    static constexpr std::size_t MAX_SEQUENCE_LENGTH = 32;
+    static constexpr std::string_view PASTE_BEGIN = "\033[200~";
+    static constexpr std::string_view PASTE_END = "\033[201~";
+
+    void feed(std::string_view data)
+    {
+        compact();
+        buffer_.append(data);
+    }
+
+    // Returns the next complete key, or nothing when the buffer is empty or ends with an incomplete sequence
+    std::optional<Key> next()
+    {
+        if (paste_)
+        {
+            return takePaste();
+        }
+
+        if (offset_ >= buffer_.size())
+        {
+            return std::nullopt;
+        }
+
+        char c = buffer_[offset_];
+        if (c != ESC)
+        {
+            offset_++;
+            steps_++;
+            return Key(c);
+        }
+
+        auto length = sequenceLength();
+        if (length == 0)
+        {
+            return std::nullopt;
+        }
+        if (std::string_view(buffer_).substr(offset_, length) == PASTE_BEGIN)
+        {
+            offset_ += length;
+            paste_ = true;
+            paste_scan_ = offset_;
+            return takePaste();
+        }
+        return takeSequence(length);
+    }
+
+    // Returns the incomplete sequence as a key (e.g. a lonely <ESC> after the timeout expired)
+    std::optional<Key> flush()
+    {
+        if (paste_)
+        {
+            paste_ = false;
+            return Key::Pasted(takeAll());
+        }
+        if (!pending())
+        {
+            return next();
+        }
+        return takeSequence(buffer_.size() - offset_);
+    }
+
+    // Returns the next raw byte, bypassing the key decoding
+    std::optional<char> takeByte()
+    {
+        if (offset_ >= buffer_.size())
+        {
+            return std::nullopt;
+        }
+        return buffer_[offset_++];
+    }
+
+    // Returns all raw bytes left in the buffer
+    std::string takeAll()
+    {
+        std::string data = buffer_.substr(offset_);
+        clear();
+        return data;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return offset_ >= buffer_.size();
+    }
+
+    // Tells whether the buffer holds only an incomplete escape sequence
+    [[nodiscard]] bool pending() const
+    {
+        return !paste_ && !empty() && buffer_[offset_] == ESC && sequenceLength() == 0;
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return buffer_.size() - offset_;
+    }
+
+    // Tells whether a bracketed paste has started but not ended yet
+    [[nodiscard]] bool pasting() const
+    {
+        return paste_;
+    }
+
+    // Bytes decoded, searched for the end of a paste or moved within the buffer so far, which grow
+    // with the input alone when decoding stays linear
+    [[nodiscard]] std::uint64_t steps() const
+    {
+        return steps_;
+    }
+
+    void clear()
+    {
+        buffer_.clear();
+        offset_ = 0;
+        paste_scan_ = 0;
+    }
+
+private:
+    std::string buffer_;
+    std::size_t offset_{0};
+    bool paste_{false};
+    std::size_t paste_scan_{0};
+    std::uint64_t steps_{0};
+
+    // Returns the whole pasted text once its end marker arrived
+    std::optional<Key> takePaste()
+    {
+        auto end = buffer_.find(PASTE_END, paste_scan_);
+        steps_ += (end == std::string::npos ? buffer_.size() : end + PASTE_END.size()) - std::min(paste_scan_, buffer_.size());
+        if (end == std::string::npos)
+        {
+            // the end marker may be split across reads, so rescan only its length
+            if (buffer_.size() - offset_ >= PASTE_END.size())
+            {
+                paste_scan_ = buffer_.size() - PASTE_END.size() + 1;
+            }
+            return std::nullopt;
+        }
+        std::string text = buffer_.substr(offset_, end - offset_);
+        steps_ += text.size();
+        offset_ = end + PASTE_END.size();
+        paste_ = false;
+        return Key::Pasted(std::move(text));
+    }
+
+    // Drops the consumed bytes once they take the bigger part of the buffer, so decoding stays linear
+    void compact()
+    {
+        if (offset_ == buffer_.size())
+        {
+            clear();
+        }
+        else if (offset_ > 4096 && offset_ * 2 > buffer_.size())
+        {
+            steps_ += buffer_.size() - offset_;
+            buffer_.erase(0, offset_);
+            paste_scan_ -= std::min(paste_scan_, offset_);
+            offset_ = 0;
+        }
+    }
+
+    // Returns length of the escape sequence at the current offset or 0 if it is not complete yet
+    [[nodiscard]] std::size_t sequenceLength() const
+    {
+        std::size_t available = buffer_.size() - offset_;
+        if (available < 2)
+        {
+            return 0;
+        }
+
+        const char *data = buffer_.data() + offset_;
+        switch (data[1])
+        {
+            case '[':
+                // CSI: parameter and intermediate bytes followed by a final byte
+                for (std::size_t i = 2; i < available; ++i)
+                {
+                    auto b = static_cast<unsigned char>(data[i]);
+                    if (b >= 0x40 && b <= 0x7e)
+                    {
+                        return i + 1;
+                    }
+                    if (b < 0x20 || b > 0x3f || i >= MAX_SEQUENCE_LENGTH)
+                    {
+                        return i;
+                    }
+                }
+                return 0;
+            case 'O':
+                // SS3: exactly one final byte
+                return available < 3 ? 0 : 3;
+            case ESC:
+                return 1;
+            default:
+                // <ALT> + key
+                return 2;
+        }
+    }
+
+    Key takeSequence(std::size_t length)
+    {
+        std::string_view sequence(buffer_.data() + offset_, length);
+        offset_ += length;
+        steps_ += length;
+        if (length == 1)
+        {
+            return Key(sequence[0]);
+        }
+        return Key(normalize(sequence));
+    }
+
+    // Maps alternative encodings of the same key onto the one used by Key constants
+    static std::string normalize(std::string_view sequence)
+    {
+        if (sequence.size() == 3 && sequence[1] == 'O' && std::string_view("ABCDHF").find(sequence[2]) != std::string_view::npos)
+        {
+            return std::string("\033[") + sequence[2];
+        }
+        if (sequence == "\033[1~" || sequence == "\033[7~")
+        {
+            return Key::Home.sequence();
+        }
+        if (sequence == "\033[4~" || sequence == "\033[8~")
+        {
+            return Key::End.sequence();
+        }
+        return std::string(sequence);
+    }
+}; /* End of class KeyDecoder */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_DECODER_H */
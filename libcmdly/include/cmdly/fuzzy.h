@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_FUZZY_H
+#define CMDLY_FUZZY_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cmdly {
+
+// Fuzzy matching in the manner of fzf: the characters of the query have to appear in the word in
+// order, anywhere. The words are kept with a bitmask of the characters they contain, so most of them
+// are ruled out by comparing masks before any scoring, and large vocabularies are scanned by several
+// threads at once, each keeping its own best matches only.
+class FuzzyMatcher
+{
+public:
+    static constexpr std::int32_t NO_MATCH = INT32_MIN;
+    // Vocabularies smaller than this are scanned by the calling thread alone
+    static constexpr std::size_t PARALLEL_THRESHOLD = 65536;
+
+    struct Match
+    {
+        std::uint32_t index;
+        std::int32_t score;
+    };
+
+    void insert(std::string word)
+    {
+        masks_.push_back(mask(word));
+        words_.push_back(std::move(word));
+    }
+
+    void clear()
+    {
+        words_.clear();
+        masks_.clear();
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return words_.size();
+    }
+
+    [[nodiscard]] const std::string &word(std::size_t index) const
+    {
+        return words_[index];
+    }
+
+    // At most limit best matches of the query, best first: higher score, then the shorter word, then
+    // the word first in order. Threads 0 means as many as the hardware runs at once.
+    [[nodiscard]] std::vector<Match> search(std::string_view query, std::size_t limit, std::size_t threads = 0) const;
+
+    // Score of the query matched in text, NO_MATCH when it does not match. The query is expected in
+    // lower case when fold is set, which makes the match ignore the case of letters in text.
+    static std::int32_t score(std::string_view text, std::string_view query, bool fold)
+    {
+        if (query.empty())
+        {
+            return 0;
+        }
+        auto equal = [fold](char c, char q) {
+            return (fold ? lower(c) : c) == q;
+        };
+        // the first place the query ends in, then the last place it starts in before that: the
+        // shortest window the query matches in
+        std::size_t end = 0;
+        for (std::size_t i = 0, q = 0; i < text.size(); ++i)
+        {
+            if (equal(text[i], query[q]) && ++q == query.size())
+            {
+                end = i + 1;
+                break;
+            }
+        }
+        if (end == 0)
+        {
+            return NO_MATCH;
+        }
+        std::size_t begin = end;
+        for (auto q = query.size(); q > 0;)
+        {
+            if (equal(text[--begin], query[q - 1]))
+            {
+                q--;
+            }
+        }
+
+        std::int32_t total = 0;
+        std::int32_t chunk_bonus = 0;
+        bool consecutive = false;
+        for (std::size_t i = begin, q = 0; i < end; ++i)
+        {
+            if (q < query.size() && equal(text[i], query[q]))
+            {
+                auto bonus = boundaryBonus(text, i);
+                if (consecutive)
+                {
+                    // a run of matched characters keeps the bonus of its first one
+                    bonus = std::max({bonus, chunk_bonus, BONUS_CONSECUTIVE});
+                }
+                else
+                {
+                    chunk_bonus = bonus;
+                }
+                total += SCORE_MATCH + (q == 0 ? bonus * BONUS_FIRST_CHAR_MULTIPLIER : bonus);
+                consecutive = true;
+                q++;
+            }
+            else
+            {
+                total += consecutive ? SCORE_GAP_START : SCORE_GAP_EXTENSION;
+                consecutive = false;
+            }
+        }
+        return total;
+    }
+
+    static char lower(char c)
+    {
+        return c >= 'A' && c <= 'Z' ? char(c | 0x20) : c;
+    }
+
+    // Bit of every character the text contains, letters without their case
+    static std::uint64_t mask(std::string_view text)
+    {
+        std::uint64_t bits = 0;
+        for (char c : text)
+        {
+            bits |= std::uint64_t(1) << bit(c);
+        }
+        return bits;
+    }
+
+private:
+    // the weights of fzf
+    static constexpr std::int32_t SCORE_MATCH = 16;
+    static constexpr std::int32_t SCORE_GAP_START = -3;
+    static constexpr std::int32_t SCORE_GAP_EXTENSION = -1;
+    static constexpr std::int32_t BONUS_BOUNDARY = 8;
+    static constexpr std::int32_t BONUS_CAMEL = 7;
+    static constexpr std::int32_t BONUS_CONSECUTIVE = 4;
+    static constexpr std::int32_t BONUS_FIRST_CHAR_MULTIPLIER = 2;
+
+    std::vector<std::string> words_;
+    std::vector<std::uint64_t> masks_;
+
+    static unsigned bit(char c)
+    {
+        auto byte = std::uint8_t(lower(c));
+        if (byte >= 'a' && byte <= 'z')
+        {
+            return byte - 'a';
+        }
+        if (byte >= '0' && byte <= '9')
+        {
+            return 26 + byte - '0';
+        }
+        return 36 + byte % 28;
+    }
+
+    static bool isWordChar(char c)
+    {
+        // bytes of multibyte characters count as letters
+        auto byte = std::uint8_t(c);
+        return (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9') || byte >= 0x80;
+    }
+
+    // Matching at the start of a word (after a separator like '/', '-' or '.'), at a capital in
+    // camelCase or at the first digit of a number is worth more
+    static std::int32_t boundaryBonus(std::string_view text, std::size_t i)
+    {
+        auto c = text[i];
+        if (i == 0)
+        {
+            return BONUS_BOUNDARY;
+        }
+        auto previous = text[i - 1];
+        if (!isWordChar(previous))
+        {
+            return isWordChar(c) ? BONUS_BOUNDARY : 0;
+        }
+        if ((previous >= 'a' && previous <= 'z' && c >= 'A' && c <= 'Z') ||
+            (!(previous >= '0' && previous <= '9') && c >= '0' && c <= '9'))
+        {
+            return BONUS_CAMEL;
+        }
+        return 0;
+    }
+
+    [[nodiscard]] bool better(const Match &match1, const Match &match2) const;
+    void scan(std::string_view query, bool fold, std::size_t begin, std::size_t end, std::size_t limit,
+              std::vector<Match> &best) const;
+}; /* End of class FuzzyMatcher */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_FUZZY_H */
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_GAP_BUFFER_H
+#define CMDLY_GAP_BUFFER_H
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace cmdly {
+
+// Text with a movable gap at the place being edited: inserting or erasing there costs only the
+// edited bytes, moving the gap costs the bytes between the old and the new place. Typing in the
+// middle of a long line keeps the gap under the cursor, so the tail is not shifted on every key.
+class GapBuffer
+{
+public:
+    GapBuffer() = default;
+
+    explicit GapBuffer(std::string_view text)
+    {
+        assign(text);
+    }
+
+    [[nodiscard]] std::size_t size() const
+    {
+        return buffer_.size() - gapSize();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return size() == 0;
+    }
+
+    [[nodiscard]] char operator[](std::size_t index) const
+    {
+        return index < gap_begin_ ? buffer_[index] : buffer_[index + gapSize()];
+    }
+
+    void insert(std::size_t index, std::string_view text)
+    {
+        index = std::min(index, size());
+        if (text.size() > gapSize())
+        {
+            grow(text.size());
+        }
+        moveGap(index);
+        std::memcpy(&buffer_[gap_begin_], text.data(), text.size());
+        gap_begin_ += text.size();
+    }
+
+    void erase(std::size_t index, std::size_t count)
+    {
+        if (index >= size())
+        {
+            return;
+        }
+        count = std::min(count, size() - index);
+        moveGap(index);
+        gap_end_ += count;
+    }
+
+    void assign(std::string_view text)
+    {
+        buffer_.assign(text);
+        buffer_.resize(text.size() + MIN_GAP);
+        gap_begin_ = text.size();
+        gap_end_ = buffer_.size();
+    }
+
+    void clear()
+    {
+        gap_begin_ = 0;
+        gap_end_ = buffer_.size();
+    }
+
+    // Text from index to the end as the two pieces around the gap, either may be empty
+    [[nodiscard]] std::pair<std::string_view, std::string_view> pieces(std::size_t index = 0) const
+    {
+        std::string_view before(buffer_.data(), gap_begin_);
+        std::string_view after(buffer_.data() + gap_end_, buffer_.size() - gap_end_);
+        if (index >= gap_begin_)
+        {
+            return {std::string_view(), after.substr(std::min(index - gap_begin_, after.size()))};
+        }
+        return {before.substr(index), after};
+    }
+
+    // Contiguous view of [from, to), the gap is moved out of the way (to its nearer end) when it is
+    // inside. The view is valid until the next change.
+    [[nodiscard]] std::string_view view(std::size_t from = 0, std::size_t to = std::string_view::npos) const
+    {
+        to = std::min(to, size());
+        from = std::min(from, to);
+        if (from < gap_begin_ && gap_begin_ < to)
+        {
+            moveGap(gap_begin_ - from < to - gap_begin_ ? from : to);
+        }
+        auto offset = from < gap_begin_ ? from : from + gapSize();
+        return {buffer_.data() + offset, to - from};
+    }
+
+    [[nodiscard]] std::string str() const
+    {
+        auto [before, after] = pieces();
+        std::string text;
+        text.reserve(before.size() + after.size());
+        text.append(before).append(after);
+        return text;
+    }
+
+    // First index at or after from where the text differs from the other one (or one of them ends)
+    [[nodiscard]] std::size_t mismatch(std::string_view other, std::size_t from = 0) const
+    {
+        auto index = from;
+        auto [before, after] = pieces(from);
+        for (auto piece : {before, after})
+        {
+            auto rest = other.substr(std::min(index, other.size()));
+            auto length = std::ptrdiff_t(std::min(piece.size(), rest.size()));
+            auto it = std::mismatch(piece.begin(), piece.begin() + length, rest.begin());
+            index += std::size_t(it.first - piece.begin());
+            if (it.first != piece.end())
+            {
+                break;
+            }
+        }
+        return index;
+    }
+
+private:
+    static constexpr std::size_t MIN_GAP = 64;
+
+    mutable std::string buffer_;
+    mutable std::size_t gap_begin_{0};
+    mutable std::size_t gap_end_{0};
+
+    [[nodiscard]] std::size_t gapSize() const
+    {
+        return gap_end_ - gap_begin_;
+    }
+
+    // Moving the gap does not change the text, so views may do it too
+    void moveGap(std::size_t index) const
+    {
+        if (index < gap_begin_)
+        {
+            auto count = gap_begin_ - index;
+            std::memmove(&buffer_[gap_end_ - count], &buffer_[index], count);
+            gap_begin_ -= count;
+            gap_end_ -= count;
+        }
+        else if (index > gap_begin_)
+        {
+            auto count = index - gap_begin_;
+            std::memmove(&buffer_[gap_begin_], &buffer_[gap_end_], count);
+            gap_begin_ += count;
+            gap_end_ += count;
+        }
+    }
+
+    // Doubles the storage at least, so inserting stays amortized constant per byte
+    void grow(std::size_t needed)
+    {
+        auto tail = buffer_.size() - gap_end_;
+        auto capacity = std::max(buffer_.size() * 2, size() + needed + MIN_GAP);
+        buffer_.resize(capacity);
+        std::memmove(&buffer_[capacity - tail], &buffer_[gap_end_], tail);
+        gap_end_ = capacity - tail;
+    }
+}; /* End of class GapBuffer */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_GAP_BUFFER_H */
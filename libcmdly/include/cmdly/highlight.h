@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_HIGHLIGHT_H
+#define CMDLY_HIGHLIGHT_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <cmdly/split_index.h>
+#include <cmdly/style.h>
+
+namespace cmdly {
+
+// Splits the content of a line into styled tokens, one token at a time. A token is lexed knowing
+// only the state left by the one before it, which lets the line lex again just the tokens around
+// an edit and keep the rest.
+class Highlighter
+{
+public:
+    using State = std::uint32_t;
+
+    // Style 0 is the content style of the line
+    static constexpr std::uint32_t CONTENT_STYLE = 0;
+
+    struct Token
+    {
+        std::size_t length;
+        std::uint32_t style;
+        State state;
+    };
+
+    virtual ~Highlighter() = default;
+
+    // Lexes the token at the start of text (the content from there to its end) in the given state,
+    // returns its length (at least 1), its style and the state the next token is lexed in
+    virtual Token next(std::string_view text, State state) = 0;
+
+    // Registers a style for tokens to refer to
+    std::uint32_t addStyle(const TextStyle &style)
+    {
+        styles_.push_back(style);
+        return std::uint32_t(styles_.size());
+    }
+
+    // The registered style, nullptr for the content style or an unknown one
+    [[nodiscard]] const TextStyle *style(std::uint32_t index) const
+    {
+        return index == CONTENT_STYLE || index > styles_.size() ? nullptr : &styles_[index - 1];
+    }
+
+protected:
+    std::vector<TextStyle> styles_;
+}; /* End of class Highlighter */
+
+// Tokens of the content as styled spans, each one remembering the state it was lexed in. Like the
+// gap buffer holding the content, the spans are split at the last edit, so an edit does not shift
+// the spans of the tail.
+class SpanIndex
+{
+public:
+    struct Span
+    {
+        std::size_t offset;
+        std::uint32_t style;
+        Highlighter::State state;
+
+        [[nodiscard]] Span mirrored(const Span &end) const
+        {
+            return {end.offset - offset, style, state};
+        }
+    };
+
+    void clear()
+    {
+        spans_.clear();
+    }
+
+    [[nodiscard]] std::size_t count() const
+    {
+        return spans_.count();
+    }
+
+    // Content from offset from was replaced with [from, new_end), the content is size bytes long now
+    // and text(pos) gives it from pos to the end. Lexing starts again at the token before the edit,
+    // in the state it was lexed in, and stops at the first old token that starts where a new one
+    // would in the same state. Returns the range of content whose style may have changed.
+    template<typename Text>
+    std::pair<std::size_t, std::size_t> edited(Highlighter &highlighter, std::size_t from, std::size_t new_end,
+                                               std::size_t size, Text text)
+    {
+        spans_.moveGap(from);
+        auto &before = spans_.before();
+        auto &after = spans_.after();
+        std::size_t pos = 0;
+        Highlighter::State state = 0;
+        Span previous{0, Highlighter::CONTENT_STYLE, 0};
+        bool resumed = !before.empty();
+        if (resumed)
+        {
+            previous = before.back();
+            pos = previous.offset;
+            state = previous.state;
+            before.pop_back();
+        }
+        // spans of the tail keep their distance from the end, the edited ones are gone
+        auto kept = size - new_end;
+        while (!after.empty() && after.back().offset > kept)
+        {
+            after.pop_back();
+        }
+        spans_.setEnd({size, Highlighter::CONTENT_STYLE, 0});
+
+        auto restyled = pos;
+        while (pos < size)
+        {
+            if (pos >= new_end)
+            {
+                while (!after.empty() && size - after.back().offset < pos)
+                {
+                    after.pop_back();
+                }
+                if (!after.empty() && size - after.back().offset == pos && after.back().state == state)
+                {
+                    break;
+                }
+            }
+            auto token = highlighter.next(text(pos), state);
+            token.length = std::clamp<std::size_t>(token.length, 1, size - pos);
+            // the token before the edit lexed again the same does not need painting
+            if (resumed && pos == previous.offset && token.style == previous.style && pos + token.length >= from)
+            {
+                restyled = from;
+            }
+            before.push_back({pos, token.style, state});
+            pos += token.length;
+            state = token.state;
+        }
+        if (pos >= size)
+        {
+            after.clear();
+        }
+        return {std::min(restyled, pos), pos};
+    }
+
+    // Calls visit(begin, end, style) for the spans in [from, to), cut to it
+    template<typename Visit>
+    void visit(std::size_t from, std::size_t to, Visit visit) const
+    {
+        to = std::min(to, spans_.end().offset);
+        if (from >= to)
+        {
+            return;
+        }
+        auto index = spans_.upperBound(from);
+        auto begin = from;
+        auto style = index > 0 ? spans_[index - 1].style : Highlighter::CONTENT_STYLE;
+        for (; index < spans_.count(); ++index)
+        {
+            auto span = spans_[index];
+            if (span.offset <= begin)
+            {
+                style = span.style;
+                continue;
+            }
+            visit(begin, std::min(span.offset, to), style);
+            begin = span.offset;
+            style = span.style;
+            if (begin >= to)
+            {
+                return;
+            }
+        }
+        visit(begin, to, style);
+    }
+
+private:
+    SplitIndex<Span> spans_;
+}; /* End of class SpanIndex */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_HIGHLIGHT_H */
@@ -5,15 +5,126 @@
 #ifndef CMDLY_HISTORY_H
 #define CMDLY_HISTORY_H
 
+#include <algorithm>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <fstream>
 #include <filesystem>
+#include <functional>
 #include <utility>
+#include <vector>
+#include <cmdly/radix_tree.h>
 
 namespace cmdly {
 
+// History lines in a radix tree where every node knows the most recent line going on past it, so
+// finding the line to suggest for a prefix walks the prefix only, whatever the history size.
+class HistoryIndex
+{
+public:
+    static constexpr std::uint64_t NONE = UINT64_MAX;
+
+    // The line becomes the most recent one, known by number from now on. Returns the number it had
+    // when it was there already, NONE otherwise.
+    std::uint64_t insert(const std::string &line, std::uint64_t number)
+    {
+        std::vector<std::size_t> path;
+        tree_.insert(line, path, [](const Lines &below) {
+            // every line below goes on past the split
+            return Lines{nullptr, below.latest, below.latest, 0};
+        });
+        auto &end = tree_[path.back()];
+        auto previous = end.line ? end.number : NONE;
+        auto shared = std::make_shared<const std::string>(line);
+        for (auto node : path)
+        {
+            tree_[node].latest = shared;
+            if (node != path.back())
+            {
+                tree_[node].longer = shared;
+            }
+        }
+        end.line = shared;
+        end.number = number;
+        return previous;
+    }
+
+    // Only the oldest line is ever erased: a node whose most recent line it is has no other line
+    // at or below it, so that part of the tree goes away with it
+    void erase(const std::string &line)
+    {
+        std::vector<std::size_t> path;
+        if (!tree_.walk(line, path) || !tree_[path.back()].line)
+        {
+            return;
+        }
+        auto shared = tree_[path.back()].line;
+        tree_[path.back()].line.reset();
+        auto cut = std::size_t(std::find_if(path.begin() + 1, path.end(), [&](std::size_t node) {
+            return tree_[node].latest == shared;
+        }) - path.begin());
+        for (std::size_t depth = 0; depth < cut && depth < path.size(); ++depth)
+        {
+            auto &node = tree_[path[depth]];
+            if (node.latest == shared)
+            {
+                node.latest.reset();
+            }
+            if (node.longer == shared)
+            {
+                node.longer.reset();
+            }
+        }
+        auto kept = path[cut - 1];
+        if (cut < path.size())
+        {
+            tree_.erase(kept, path[cut]);
+        }
+        // a node left with neither a line of its own nor a branch takes in its only child
+        if (kept != 0 && !tree_[kept].line && tree_.children(kept).size() == 1)
+        {
+            tree_.join(kept);
+        }
+    }
+
+    // The most recent line starting with prefix and longer than it, empty when there is none
+    [[nodiscard]] std::string_view suggest(std::string_view prefix) const
+    {
+        std::size_t depth;
+        auto node = tree_.descend(prefix, depth);
+        if (node == RadixTree<Lines>::NONE)
+        {
+            return {};
+        }
+        // a prefix ending inside an edge has every line below going on past it
+        auto &line = depth > prefix.size() ? tree_[node].latest : tree_[node].longer;
+        return line ? std::string_view(*line) : std::string_view();
+    }
+
+    void clear()
+    {
+        tree_.clear();
+    }
+
+private:
+    struct Lines
+    {
+        // the line ending at this node
+        std::shared_ptr<const std::string> line;
+        // the most recent line at or below this node
+        std::shared_ptr<const std::string> latest;
+        // the most recent line below this node, longer than the path to it
+        std::shared_ptr<const std::string> longer;
+        // the number the line ending at this node was entered with
+        std::uint64_t number{0};
+    };
+
+    RadixTree<Lines> tree_;
+}; /* End of class HistoryIndex */
+
 class History
 {
 public:
@@ -35,23 +146,33 @@ public:
             return;
         }
 
-        for (std::size_t i = 0; i < lines_.size(); ++i)
+        auto number = ++entered_;
+        auto previous = prefixes_.insert(line, number);
+        if (previous != HistoryIndex::NONE)
         {
-            if (lines_[i] == line)
-            {
-                lines_.erase(lines_.begin() + int(i));
-                lines_.push_front(line);
-                return;
-            }
+            // a line entered again moves to the front, the numbers fall from the front to the back
+            // so the one it had finds where it was
+            auto at = std::lower_bound(numbers_.begin(), numbers_.end(), previous, std::greater<>()) - numbers_.begin();
+            lines_.erase(lines_.begin() + at);
+            numbers_.erase(numbers_.begin() + at);
         }
-
         lines_.push_front(line);
+        numbers_.push_front(number);
         if (lines_.size() > limit_)
         {
+            prefixes_.erase(lines_.back());
             lines_.pop_back();
+            numbers_.pop_back();
         }
     }
 
+    // The most recent line starting with prefix and longer than it (for suggesting the rest of it
+    // while typing), empty when there is none
+    [[nodiscard]] std::string_view suggest(std::string_view prefix) const
+    {
+        return prefixes_.suggest(prefix);
+    }
+
     const std::deque<std::string>& lines()
     {
         return lines_;
@@ -65,6 +186,8 @@ public:
     void clear()
     {
         lines_.clear();
+        numbers_.clear();
+        prefixes_.clear();
     }
 
     void rewind()
@@ -117,6 +240,10 @@ protected:
     int index_;
     std::string top_line_;
     std::deque<std::string> lines_;
+    // the number every line was entered with, in the order of the lines
+    std::deque<std::uint64_t> numbers_;
+    std::uint64_t entered_{0};
+    HistoryIndex prefixes_;
 }; /* End of class History */
 
 class MemoryHistory : public History
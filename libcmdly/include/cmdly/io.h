@@ -5,10 +5,24 @@
 #ifndef CMDLY_IO_H
 #define CMDLY_IO_H
 
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
+#include <termios.h>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <csignal>
 #include <cstdint>
-#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <string_view>
 #include <cmdly/exception.h>
+#include <cmdly/decoder.h>
 #include <cmdly/key.h>
 
 namespace cmdly {
@@ -16,91 +30,399 @@ namespace cmdly {
 class IO
 {
 public:
+    // Counters of system calls issued by the IO (only real devices fill them)
+    struct Statistics
+    {
+        std::uint64_t reads{0};
+        std::uint64_t writes{0};
+        std::uint64_t termios_calls{0};
+        std::uint64_t bytes_read{0};
+        std::uint64_t bytes_written{0};
+    }; /* End of struct Statistics */
+
     virtual ~IO() = default;
     virtual Key getKey() = 0;
     virtual char getChar() = 0;
     virtual void write(const std::string &data) const = 0;
     virtual void getWindowSize(std::size_t *cols, std::size_t *rows) const = 0;
 
-    const IO &operator<<(const Key &key) const
+    // Descriptor becoming readable when the window was resized, or -1 if the IO can't tell
+    [[nodiscard]] virtual int resizeDescriptor() const
     {
-        write(key.str());
-        return *this;
+        return -1;
     }
 
-    const IO &operator<<(const std::string &s) const
+    // Tells whether the window was resized since the last check
+    virtual bool checkResize()
     {
-        write(s);
-        return *this;
+        return false;
+    }
+
+    // Makes a blocked getKey() return Key::WakeUp, safe to call from any thread
+    virtual void wakeUp()
+    {}
+
+    // Descriptor becoming readable after wakeUp(), or -1 if the IO can't be woken up
+    [[nodiscard]] virtual int wakeUpDescriptor() const
+    {
+        return -1;
+    }
+
+    // Tells whether wakeUp() was called since the last check
+    virtual bool checkWakeUp()
+    {
+        return false;
+    }
+
+    virtual void enterRawMode()
+    {}
+
+    virtual void exitRawMode()
+    {}
+
+    // False when input or output is not a terminal (e.g. a script piped in), lines are then read in batch
+    [[nodiscard]] virtual bool isInteractive() const
+    {
+        return true;
+    }
+
+    // Descriptor an event loop can watch for input, or -1 if the IO can't be polled
+    [[nodiscard]] virtual int inputDescriptor() const
+    {
+        return -1;
+    }
+
+    // Waits until input is ready, false on timeout
+    virtual bool waitForInput(std::chrono::milliseconds)
+    {
+        return true;
+    }
+
+    // Reads the input that is ready without blocking, nothing means the end of input
+    virtual std::optional<std::string> readAvailable()
+    {
+        return std::nullopt;
+    }
+
+    [[nodiscard]] const Statistics &statistics() const
+    {
+        return statistics_;
+    }
+
+    // Starts collecting output, so it can be written at once when the outermost frame ends
+    void beginFrame()
+    {
+        frame_depth_++;
+    }
+
+    void endFrame()
+    {
+        if (frame_depth_ > 0 && --frame_depth_ == 0)
+        {
+            flush();
+        }
     }
 
-    const IO &operator<<(std::uint32_t v) const
+    // Writes all collected output with a single write
+    void flush()
     {
-        write(std::to_string(v));
+        if (buffer_.empty())
+        {
+            return;
+        }
+        // the buffer keeps its capacity, so frames after the first one do not allocate
+        try
+        {
+            write(buffer_);
+        }
+        catch (...)
+        {
+            buffer_.clear();
+            throw;
+        }
+        buffer_.clear();
+    }
+
+    IO &operator<<(const Key &key)
+    {
+        return *this << key.str();
+    }
+
+    IO &operator<<(std::string_view s)
+    {
+        buffer_.append(s);
+        if (frame_depth_ == 0 || buffer_.size() >= FRAME_BUFFER_LIMIT)
+        {
+            flush();
+        }
         return *this;
     }
+
+    IO &operator<<(const std::string &s)
+    {
+        return *this << std::string_view(s);
+    }
+
+    IO &operator<<(const char *s)
+    {
+        return *this << std::string_view(s);
+    }
+
+    IO &operator<<(std::uint32_t v)
+    {
+        char digits[10];
+        auto end = std::to_chars(digits, digits + sizeof(digits), v).ptr;
+        return *this << std::string_view(digits, std::size_t(end - digits));
+    }
+
+protected:
+    static constexpr std::size_t FRAME_BUFFER_LIMIT = 64 * 1024;
+
+    mutable Statistics statistics_;
+    std::string buffer_;
+    std::uint32_t frame_depth_{0};
 }; /* End of class IO */
 
-class StandardIO : public IO
+// Batches everything written to the IO during its lifetime into one write
+class Frame
 {
 public:
-    StandardIO() = default;
+    explicit Frame(IO &io) :
+        io_(io), uncaught_exceptions_(std::uncaught_exceptions())
+    {
+        io_.beginFrame();
+    }
 
-    Key getKey() override
+    ~Frame() noexcept(false)
     {
-        char buf[16] = {0};
-        ::fflush(stdout);
-        enterRawMode();
-        auto len = read(STDIN_FILENO, buf, sizeof(buf));
-        exitRawMode();
-        if (len <= 0)
+        if (std::uncaught_exceptions() == uncaught_exceptions_)
         {
-            return Key::Ctrl('d');
+            io_.endFrame();
+            return;
         }
-        if (len == 1)
+        try
         {
-            return Key(buf[0]);
+            io_.endFrame();
         }
-        return Key(std::string(buf, len));
+        catch (const IOError &)
+        {}
     }
 
-    char getChar() override
+    Frame(const Frame &) = delete;
+    Frame &operator=(const Frame &) = delete;
+
+private:
+    IO &io_;
+    int uncaught_exceptions_;
+}; /* End of class Frame */
+
+// Keeps the IO in raw mode for the lifetime of the object (sessions may be nested)
+class RawMode
+{
+public:
+    explicit RawMode(IO &io) :
+        io_(io)
     {
-        char c;
-        ssize_t len = 0;
+        io_.enterRawMode();
+    }
 
-        enterRawMode();
-        do
+    ~RawMode()
+    {
+        io_.exitRawMode();
+    }
+
+    RawMode(const RawMode &) = delete;
+    RawMode &operator=(const RawMode &) = delete;
+
+private:
+    IO &io_;
+}; /* End of class RawMode */
+
+class StandardIO : public IO
+{
+public:
+    explicit StandardIO(int input_fd = STDIN_FILENO, int output_fd = STDOUT_FILENO) :
+        input_fd_(input_fd), output_fd_(output_fd), wake_fd_(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+    {
+        if (wake_fd_ < 0)
+        {
+            throw IOError("could not create wake-up descriptor");
+        }
+        if (::isatty(input_fd_))
         {
-            len = read(STDIN_FILENO, &c, 1);
-            if (len < 0)
+            installResizeHandler();
+        }
+        resize_generation_seen_ = resize_generation_.load();
+    }
+
+    ~StandardIO() override
+    {
+        if (raw_mode_depth_ > 0)
+        {
+            raw_mode_depth_ = 1;
+            exitRawMode();
+        }
+        ::close(wake_fd_);
+    }
+
+    StandardIO(const StandardIO &) = delete;
+    StandardIO &operator=(const StandardIO &) = delete;
+
+    Key getKey() override
+    {
+        flush();
+        RawMode raw_mode(*this);
+        for (;;)
+        {
+            if (auto key = decoder_.next())
+            {
+                return *key;
+            }
+            if (checkResize())
+            {
+                return Key::Resize;
+            }
+            if (checkWakeUp())
             {
-                if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                return Key::WakeUp;
+            }
+            auto ready = waitReady(decoder_.pending() ? esc_timeout_ : std::chrono::milliseconds(-1));
+            if (ready == Ready::Timeout)
+            {
+                // the sequence left pending is taken as it is
+                if (auto key = decoder_.flush())
                 {
-                    continue;
+                    return *key;
+                }
+                continue;
+            }
+            if (ready == Ready::Interrupted)
+            {
+                continue;
+            }
+            auto len = fill();
+            if (len == 0)
+            {
+                if (auto key = decoder_.flush())
+                {
+                    return *key;
                 }
+                return Key::Ctrl('d');
             }
-            break;
         }
-        while (true);
-        exitRawMode();
+    }
 
-        if (len != 1)
+    char getChar() override
+    {
+        flush();
+        RawMode raw_mode(*this);
+        while (decoder_.empty())
         {
-            return -1;
+            if (fill() == 0)
+            {
+                return -1;
+            }
         }
+        return *decoder_.takeByte();
+    }
+
+    [[nodiscard]] int inputDescriptor() const override
+    {
+        return input_fd_;
+    }
+
+    [[nodiscard]] bool isInteractive() const override
+    {
+        return ::isatty(input_fd_) && ::isatty(output_fd_);
+    }
+
+    std::optional<std::string> readAvailable() override
+    {
+        if (!decoder_.empty())
+        {
+            return decoder_.takeAll();
+        }
+
+        char buf[READ_BUFFER_SIZE];
+        auto len = ::read(input_fd_, buf, sizeof(buf));
+        statistics_.reads++;
+        if (len < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            return std::string();
+        }
+        if (len <= 0)
+        {
+            return std::nullopt;
+        }
+        statistics_.bytes_read += len;
+        return std::string(buf, len);
+    }
 
-        return c;
+    bool waitForInput(std::chrono::milliseconds timeout) override
+    {
+        return !decoder_.empty() || pollInput(timeout);
     }
 
+    // Sets how long to wait for the rest of an escape sequence before <ESC> is taken as a key
+    void setEscTimeout(std::chrono::milliseconds timeout)
+    {
+        esc_timeout_ = timeout;
+    }
+
+    // Returns the cached size, it is read again only after SIGWINCH (safe to call from any thread)
     void getWindowSize(std::size_t *cols, std::size_t *rows) const override
     {
-        struct winsize ws = {};
-        (void) ioctl(STDIN_FILENO, TIOCGWINSZ, &ws);
-        *cols = ws.ws_col;
-        *rows = ws.ws_row;
-        *cols = *cols > 1 ? *cols : 160;
-        *rows = *rows > 1 ? *rows : 24;
+        auto generation = resize_generation_.load(std::memory_order_acquire);
+        auto size = window_size_.load(std::memory_order_acquire);
+        if (size == 0 || window_size_generation_.load(std::memory_order_acquire) != generation)
+        {
+            struct winsize ws = {};
+            (void) ioctl(input_fd_, TIOCGWINSZ, &ws);
+            std::uint64_t ws_cols = ws.ws_col > 1 ? ws.ws_col : 160;
+            std::uint64_t ws_rows = ws.ws_row > 1 ? ws.ws_row : 24;
+            size = (ws_cols << 32) | ws_rows;
+            window_size_.store(size, std::memory_order_release);
+            window_size_generation_.store(generation, std::memory_order_release);
+        }
+        *cols = std::size_t(size >> 32);
+        *rows = std::size_t(size & 0xffffffff);
+    }
+
+    [[nodiscard]] int resizeDescriptor() const override
+    {
+        return ::isatty(input_fd_) ? resize_pipe_[0] : -1;
+    }
+
+    void wakeUp() override
+    {
+        std::uint64_t one = 1;
+        (void) !::write(wake_fd_, &one, sizeof(one));
+    }
+
+    [[nodiscard]] int wakeUpDescriptor() const override
+    {
+        return wake_fd_;
+    }
+
+    bool checkWakeUp() override
+    {
+        std::uint64_t count = 0;
+        return ::read(wake_fd_, &count, sizeof(count)) == sizeof(count) && count > 0;
+    }
+
+    bool checkResize() override
+    {
+        auto generation = resize_generation_.load(std::memory_order_acquire);
+        if (generation == resize_generation_seen_)
+        {
+            return false;
+        }
+        resize_generation_seen_ = generation;
+
+        char buf[64];
+        while (::read(resize_pipe_[0], buf, sizeof(buf)) > 0)
+        {}
+        return true;
     }
 
     void write(const std::string &data) const override
@@ -108,35 +430,294 @@ public:
         std::size_t bytes_written = 0;
         while (bytes_written < data.length())
         {
-            ssize_t retval = ::write(STDOUT_FILENO, data.c_str() + bytes_written, data.length() - bytes_written);
+            ssize_t retval = ::write(output_fd_, data.c_str() + bytes_written, data.length() - bytes_written);
+            statistics_.writes++;
             if (retval < 0)
             {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
                 throw IOError("could not write data");
             }
             bytes_written += retval;
         }
+        statistics_.bytes_written += bytes_written;
     }
 
-protected:
-    struct termios term_{};
-
-    void enterRawMode()
+    // Switches termios only when the outermost raw mode session begins
+    void enterRawMode() override
     {
-        tcgetattr(STDIN_FILENO, &term_);
+        if (raw_mode_depth_++ > 0)
+        {
+            return;
+        }
+
+        statistics_.termios_calls++;
+        if (tcgetattr(input_fd_, &term_) < 0)
+        {
+            term_saved_ = false;
+            return;
+        }
+        term_saved_ = true;
+
         struct termios term = term_;
         term.c_iflag &= ~(BRKINT | ICRNL | INPCK | ISTRIP | IXON);
         term.c_lflag &= ~(ECHO | ICANON | IEXTEN | ISIG);
         term.c_cflag |= CS8;
         term.c_cc[VMIN] = 1;
         term.c_cc[VTIME] = 0;
-        tcsetattr(STDIN_FILENO, TCSANOW, &term);
+        installSignalHandlers();
+        statistics_.termios_calls++;
+        tcsetattr(input_fd_, TCSANOW, &term);
+    }
+
+    // Restores termios only when the outermost raw mode session ends
+    void exitRawMode() override
+    {
+        if (raw_mode_depth_ == 0 || --raw_mode_depth_ > 0)
+        {
+            return;
+        }
+
+        if (term_saved_)
+        {
+            statistics_.termios_calls++;
+            tcsetattr(input_fd_, TCSADRAIN, &term_);
+            uninstallSignalHandlers();
+            term_saved_ = false;
+        }
+    }
+
+protected:
+    int input_fd_;
+    int output_fd_;
+    int wake_fd_;
+    struct termios term_{};
+    bool term_saved_{false};
+    std::uint32_t raw_mode_depth_{0};
+    KeyDecoder decoder_;
+    std::chrono::milliseconds esc_timeout_{100};
+
+    mutable std::atomic<std::uint64_t> window_size_{0};
+    mutable std::atomic<std::uint32_t> window_size_generation_{0};
+    std::uint32_t resize_generation_seen_{0};
+
+    // Reads whatever input is available (at least one byte) into the decoder, -1 when interrupted by resize
+    ssize_t fill()
+    {
+        char buf[READ_BUFFER_SIZE];
+        auto len = read(buf, sizeof(buf));
+        if (len < 0 && errno == EINTR)
+        {
+            return -1;
+        }
+        if (len <= 0)
+        {
+            return 0;
+        }
+        decoder_.feed(std::string_view(buf, len));
+        return len;
     }
 
-    void exitRawMode() const
+    bool pollInput(std::chrono::milliseconds timeout)
     {
-        tcsetattr(STDIN_FILENO, TCSADRAIN, &term_);
+        struct pollfd pfd = {input_fd_, POLLIN, 0};
+        int retval;
+        do
+        {
+            retval = ::poll(&pfd, 1, int(timeout.count()));
+        }
+        while (retval < 0 && errno == EINTR);
+        return retval > 0;
     }
 
+    enum class Ready
+    {
+        Timeout,
+        Input,
+        Interrupted,    // woken up or resized
+    };
+
+    // Waits for input or a wake-up, a resize interrupts the wait as well; throws when the wait fails
+    Ready waitReady(std::chrono::milliseconds timeout)
+    {
+        struct pollfd pfds[3] = {{input_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}, {resizeDescriptor(), POLLIN, 0}};
+        int retval;
+        do
+        {
+            retval = ::poll(pfds, pfds[2].fd >= 0 ? 3 : 2, int(timeout.count()));
+            if (retval < 0 && errno == EINTR && resize_generation_.load() != resize_generation_seen_)
+            {
+                return Ready::Interrupted;
+            }
+        }
+        while (retval < 0 && errno == EINTR);
+
+        if (retval < 0)
+        {
+            throw IOError("could not wait for input");
+        }
+        if (retval == 0)
+        {
+            return Ready::Timeout;
+        }
+        return pfds[1].revents != 0 || pfds[2].revents != 0 ? Ready::Interrupted : Ready::Input;
+    }
+
+    ssize_t read(char *buf, std::size_t size)
+    {
+        ssize_t len;
+        do
+        {
+            len = ::read(input_fd_, buf, size);
+            statistics_.reads++;
+            if (len < 0 && errno == EINTR && resize_generation_.load() != resize_generation_seen_)
+            {
+                break;
+            }
+        }
+        while (len < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK));
+        if (len > 0)
+        {
+            statistics_.bytes_read += len;
+        }
+        return len;
+    }
+
+private:
+    static constexpr std::size_t READ_BUFFER_SIZE = 64 * 1024;
+    static constexpr int SIGNALS[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT};
+
+    // SIGWINCH bumps the generation and wakes up event loops through the self-pipe, then goes on to
+    // the handler the application had
+    static inline std::atomic<std::uint32_t> resize_generation_{0};
+    static inline int resize_pipe_[2] = {-1, -1};
+    static inline struct sigaction old_resize_action_{};
+
+    static void installResizeHandler()
+    {
+        static std::once_flag once;
+        std::call_once(once, []() {
+            if (::pipe2(resize_pipe_, O_NONBLOCK | O_CLOEXEC) < 0)
+            {
+                throw IOError("could not create resize pipe");
+            }
+            // system calls of the rest of the process are restarted, waits for input learn about
+            // the resize from the pipe
+            struct sigaction action{};
+            action.sa_sigaction = &StandardIO::resizeHandler;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+            sigaction(SIGWINCH, &action, &old_resize_action_);
+        });
+    }
+
+    static void resizeHandler(int signum, siginfo_t *info, void *context)
+    {
+        int saved_errno = errno;
+        resize_generation_.fetch_add(1, std::memory_order_release);
+        (void) !::write(resize_pipe_[1], "w", 1);
+        errno = saved_errno;
+
+        if (old_resize_action_.sa_flags & SA_SIGINFO)
+        {
+            old_resize_action_.sa_sigaction(signum, info, context);
+        }
+        else if (old_resize_action_.sa_handler != SIG_DFL && old_resize_action_.sa_handler != SIG_IGN)
+        {
+            old_resize_action_.sa_handler(signum);
+        }
+    }
+
+    // Terminals in raw mode, all of them restored by the signal handler, which must not touch the
+    // StandardIO objects. A slot is taken by setting its descriptor, after the termios to restore.
+    struct SignalSlot
+    {
+        std::atomic<int> fd{-1};
+        struct termios term{};
+    };
+
+    // terminals the handler restores at most
+    static constexpr std::size_t SIGNAL_SLOTS = 32;
+    static inline std::mutex signal_mutex_;
+    // instances in raw mode, the handlers are installed while there are any
+    static inline std::size_t signal_users_{0};
+    static inline struct sigaction old_actions_[std::size(SIGNALS)]{};
+
+    // slot of this instance, -1 when it has none
+    int signal_slot_{-1};
+
+    // constant initialized, the handler finds them in place
+    static SignalSlot *signalSlots()
+    {
+        static SignalSlot slots[SIGNAL_SLOTS];
+        return slots;
+    }
+
+    void installSignalHandlers()
+    {
+        std::lock_guard<std::mutex> lock(signal_mutex_);
+        auto slots = signalSlots();
+        for (std::size_t i = 0; i < SIGNAL_SLOTS; ++i)
+        {
+            if (slots[i].fd.load() < 0)
+            {
+                slots[i].term = term_;
+                slots[i].fd.store(input_fd_);
+                signal_slot_ = int(i);
+                break;
+            }
+        }
+        if (signal_users_++ > 0)
+        {
+            return;
+        }
+        struct sigaction action{};
+        action.sa_handler = &StandardIO::signalHandler;
+        sigemptyset(&action.sa_mask);
+        for (std::size_t i = 0; i < std::size(SIGNALS); ++i)
+        {
+            sigaction(SIGNALS[i], &action, &old_actions_[i]);
+        }
+    }
+
+    void uninstallSignalHandlers()
+    {
+        std::lock_guard<std::mutex> lock(signal_mutex_);
+        if (signal_slot_ >= 0)
+        {
+            signalSlots()[signal_slot_].fd.store(-1);
+            signal_slot_ = -1;
+        }
+        if (signal_users_ == 0 || --signal_users_ > 0)
+        {
+            return;
+        }
+        for (std::size_t i = 0; i < std::size(SIGNALS); ++i)
+        {
+            sigaction(SIGNALS[i], &old_actions_[i], nullptr);
+        }
+    }
+
+    // Restores every terminal in raw mode and re-raises the signal with the previous disposition
+    static void signalHandler(int signum)
+    {
+        auto slots = signalSlots();
+        for (std::size_t i = 0; i < SIGNAL_SLOTS; ++i)
+        {
+            auto fd = slots[i].fd.load();
+            if (fd >= 0)
+            {
+                tcsetattr(fd, TCSANOW, &slots[i].term);
+            }
+        }
+        for (std::size_t i = 0; i < std::size(SIGNALS); ++i)
+        {
+            sigaction(SIGNALS[i], &old_actions_[i], nullptr);
+        }
+        raise(signum);
+    }
 }; /* End of class StandardIO */
 
 
@@ -35,6 +35,9 @@ public:
     static Key F2;
     static Key F3;
     static Key F4;
+    static Key Paste;
+    static Key Resize;
+    static Key WakeUp;
 
     static Key Ctrl(char c)
     {
@@ -43,7 +46,15 @@ public:
 
     static Key Alt(char c)
     {
-        return Key(string::format("\033[{}", int(c)));
+        return Key(std::string("\033") + c);
+    }
+
+    // Text pasted at once (bracketed paste), it compares equal to Key::Paste
+    static Key Pasted(std::string text)
+    {
+        Key key = Key::Paste;
+        key.text_ = std::move(text);
+        return key;
     }
 
     explicit Key(char code) :
@@ -69,14 +80,24 @@ public:
         return sequence_;
     }
 
+    [[nodiscard]] std::string_view text() const
+    {
+        return text_;
+    }
+
     [[nodiscard]] bool isSpecial() const
     {
         return special_;
     }
 
+    [[nodiscard]] bool isPaste() const
+    {
+        return *this == Key::Paste;
+    }
+
     [[nodiscard]] bool isPrintable() const
     {
-        return !special_ && std::isprint(code_);
+        return !special_ && std::isprint(static_cast<unsigned char>(code_));
     }
 
     [[nodiscard]] std::string str() const
@@ -93,7 +114,11 @@ public:
         std::ostringstream oss;
 
         oss << "<Key ";
-        if (special_)
+        if (isPaste())
+        {
+            oss << "paste length=" << text_.size();
+        }
+        else if (special_)
         {
             oss << "sequence=\"";
             for (auto& c : sequence_)
@@ -156,6 +181,7 @@ private:
     char code_;
     bool special_;
     std::string sequence_;
+    std::string text_;
 }; /* End of class Key */
 
 } /* End of namespace cmdly */
@@ -5,23 +5,155 @@
 #ifndef CMDLY_LINE_H
 #define CMDLY_LINE_H
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
+#include <cmdly/gap_buffer.h>
+#include <cmdly/highlight.h>
+#include <cmdly/motion.h>
 #include <cmdly/style.h>
 #include <cmdly/io.h>
+#include <cmdly/utf8.h>
 
 namespace cmdly {
 
+// Character clusters of content with non-ASCII text: where each begins (in bytes and columns), ended
+// by a sentinel at the end. Like the spans of a SpanIndex they are split at the last edit, the ones
+// after it with columns counted back from the end too, so an edit leaves them as they are.
+class ClusterIndex
+{
+public:
+    struct Cluster
+    {
+        std::size_t offset;
+        std::size_t column;
+
+        [[nodiscard]] Cluster mirrored(const Cluster &end) const
+        {
+            return {end.offset - offset, end.column - column};
+        }
+    };
+
+    void clear()
+    {
+        clusters_.clear();
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return clusters_.empty();
+    }
+
+    // Clusters with the sentinel
+    [[nodiscard]] std::size_t count() const
+    {
+        return clusters_.count();
+    }
+
+    // Columns of the whole content
+    [[nodiscard]] std::size_t width() const
+    {
+        return clusters_.end().column;
+    }
+
+    [[nodiscard]] Cluster operator[](std::size_t index) const
+    {
+        return clusters_[index];
+    }
+
+    // The cluster holding the byte at offset
+    [[nodiscard]] std::size_t find(std::size_t offset) const
+    {
+        return clusters_.upperBound(offset) - 1;
+    }
+
+    // The first cluster at column or after it, the sentinel when there is none
+    [[nodiscard]] std::size_t findColumn(std::size_t column) const
+    {
+        auto &before = clusters_.before();
+        auto &after = clusters_.after();
+        auto width = clusters_.end().column;
+        auto it = std::lower_bound(before.begin(), before.end(), column,
+                                   [](const Cluster &c, std::size_t value) { return c.column < value; });
+        if (it != before.end() || column > width)
+        {
+            return std::min(std::size_t(it - before.begin()), count() - 1);
+        }
+        auto past = std::size_t(std::upper_bound(after.begin(), after.end(), width - column,
+                                                 [](std::size_t value, const Cluster &c) { return value < c.column; }) -
+                                after.begin());
+        return std::min(count() - past, count() - 1);
+    }
+
+    // Content from offset from was replaced with [from, new_end), the content is size bytes long now
+    // and length(pos, &columns) gives the cluster at pos. Scanning starts at the cluster before the
+    // edit, as a mark joins the cluster before it, and stops at the first old cluster starting where
+    // a new one does.
+    template<typename Length>
+    void edited(std::size_t from, std::size_t new_end, std::size_t size, Length length)
+    {
+        clusters_.moveGap(from);
+        auto &before = clusters_.before();
+        auto &after = clusters_.after();
+        bool boundary = !after.empty() && clusters_.end().offset - after.back().offset == from;
+        if (!boundary && !before.empty())
+        {
+            before.pop_back();
+        }
+        Cluster start{0, 0};
+        if (!before.empty())
+        {
+            start = before.back();
+            before.pop_back();
+        }
+        // clusters of the tail keep their distance from the end, the edited ones are gone
+        auto kept = size - new_end;
+        while (!after.empty() && after.back().offset > kept)
+        {
+            after.pop_back();
+        }
+
+        auto [pos, column] = start;
+        while (pos < size)
+        {
+            if (pos >= new_end)
+            {
+                while (!after.empty() && size - after.back().offset < pos)
+                {
+                    after.pop_back();
+                }
+                if (!after.empty() && size - after.back().offset == pos)
+                {
+                    clusters_.setEnd({size, column + after.back().column});
+                    return;
+                }
+            }
+            std::size_t columns;
+            auto cluster_length = length(pos, &columns);
+            before.push_back({pos, column});
+            pos += cluster_length;
+            column += columns;
+        }
+        after.assign(1, {0, 0});
+        clusters_.setEnd({size, column});
+    }
+
+private:
+    SplitIndex<Cluster> clusters_;
+}; /* End of class ClusterIndex */
+
 class Line
 {
 public:
     Line() = default;
 
     Line(const std::string &prompt, TextStyle prompt_style, TextStyle content_style, const std::shared_ptr<IO> &io) :
-        data_(prompt),
         prompt_(prompt),
+        prompt_width_(utf8::columns(prompt)),
         prompt_style_(std::move(prompt_style)),
         content_style_(std::move(content_style)),
         io_(io)
@@ -29,92 +161,728 @@ public:
         update();
     }
 
+    // A new style needs the whole line drawn again
     void setPromptStyle(const TextStyle& text_style)
     {
         prompt_style_ = text_style;
+        invalidate();
     }
 
     void setContentStyle(const TextStyle& text_style)
     {
         content_style_ = text_style;
+        invalidate();
     }
 
-    const std::string &str()
+    // Content is drawn in the styles of the tokens the highlighter splits it into, nullptr draws it
+    // in the content style alone
+    void setHighlighter(const std::shared_ptr<Highlighter> &highlighter)
     {
-        return data_;
+        highlighter_ = highlighter;
+        spans_.clear();
+        if (highlighter_)
+        {
+            highlight(0, content_.size());
+        }
+        if (!content_.empty())
+        {
+            invalidate();
+        }
+    }
+
+    [[nodiscard]] const std::shared_ptr<Highlighter> &highlighter() const
+    {
+        return highlighter_;
     }
 
-    const std::string &prompt()
+    // Prompt followed by the content
+    [[nodiscard]] std::string str() const
+    {
+        return prompt_ + content_.str();
+    }
+
+    [[nodiscard]] const std::string &prompt() const
     {
         return prompt_;
     }
 
-    std::string content()
+    // The view is valid until the line is changed
+    [[nodiscard]] std::string_view content() const
     {
-        return data_.substr(prompt_.size(), data_.size());
+        return content_.view();
+    }
+
+    // Changes with every edit of the content, cheaper to compare than the content itself
+    [[nodiscard]] std::uint64_t revision() const
+    {
+        return revision_;
+    }
+
+    // Length in bytes, prompt included
+    [[nodiscard]] std::size_t length() const
+    {
+        return prompt_.size() + content_.size();
+    }
+
+    // Columns taken on the screen, prompt included
+    [[nodiscard]] std::size_t width() const
+    {
+        return prompt_width_ + (clusters_.empty() ? content_.size() : clusters_.width());
+    }
+
+    // Screen column (0-based) of the character cluster holding the byte at index
+    [[nodiscard]] std::size_t columnAt(std::size_t index) const
+    {
+        if (index < prompt_.size())
+        {
+            return utf8::columns(std::string_view(prompt_).substr(0, index));
+        }
+        auto offset = std::min(index - prompt_.size(), content_.size());
+        return prompt_width_ + (clusters_.empty() ? offset : clusters_[clusters_.find(offset)].column);
+    }
+
+    // Byte index where the character cluster after the one at index begins
+    [[nodiscard]] std::size_t nextBoundary(std::size_t index) const
+    {
+        if (index >= length())
+        {
+            return length();
+        }
+        if (index < prompt_.size() || clusters_.empty())
+        {
+            return index + 1;
+        }
+        return prompt_.size() + clusters_[clusters_.find(index - prompt_.size()) + 1].offset;
     }
 
-    std::size_t length()
+    // Byte index where the character cluster before index begins
+    [[nodiscard]] std::size_t prevBoundary(std::size_t index) const
     {
-        return data_.size();
+        index = std::min(index, length());
+        if (index <= prompt_.size() || clusters_.empty())
+        {
+            return index > 0 ? index - 1 : 0;
+        }
+        return prompt_.size() + clusters_[clusters_.find(index - prompt_.size() - 1)].offset;
     }
 
     void remove(int index)
     {
-        if (index < int(prompt_.size()) || index >= int(data_.size()))
+        if (index < 0)
         {
             return;
         }
-        data_.erase(data_.begin() + index);
+        erase(std::size_t(index), 1);
+    }
+
+    void erase(std::size_t index, std::size_t count)
+    {
+        if (index < prompt_.size() || index >= length())
+        {
+            return;
+        }
+        auto from = index - prompt_.size();
+        count = std::min(count, content_.size() - from);
+        if (non_ascii_ > 0)
+        {
+            non_ascii_ -= nonAsciiBytes(content_.view(from, from + count));
+        }
+        content_.erase(from, count);
+        edited(from, from);
     }
 
     void insert(int index, char c)
     {
-        if (index < int(prompt_.size()) || index > int(data_.size()))
+        insert(index, std::string_view(&c, 1));
+    }
+
+    void insert(int index, std::string_view s)
+    {
+        if (index < int(prompt_.size()) || index > int(length()))
         {
             return;
         }
-        data_.insert(data_.begin() + index, c);
+        auto from = std::size_t(index) - prompt_.size();
+        non_ascii_ += nonAsciiBytes(s);
+        content_.insert(from, s);
+        edited(from, from + s.size());
     }
 
     void append(char c)
     {
-        data_.push_back(c);
+        insert(int(length()), std::string_view(&c, 1));
     }
 
-    void append(const std::string &s)
+    void append(std::string_view s)
     {
-        data_ += s;
+        insert(int(length()), s);
     }
 
-    void setContent(const std::string &content)
+    void setContent(std::string_view content)
     {
-        data_ = prompt_ + content;
+        non_ascii_ = nonAsciiBytes(content);
+        content_.assign(content);
+        clusters_.clear();
+        edited(0, content_.size());
     }
 
+    // Brings the screen up to date, the content first and the suggestion after it
     void update()
     {
+        updateContent();
+        updateSuggestion();
+    }
+
+    // Brings the content on the screen up to date with the least output: nothing, an append, an
+    // erase to the end of the line, or a rewrite from the first column that differs. Everything is
+    // drawn after invalidate().
+    void updateContent()
+    {
+        if (scrolling())
+        {
+            // the visible window is never wider than the terminal, so it is simply drawn again
+            if (screen_col_ == 0 || dirty_ != NOT_DIRTY || !viewport_shown_)
+            {
+                drawViewport();
+            }
+            return;
+        }
+        if (screen_col_ == 0 || viewport_shown_)
+        {
+            redraw();
+            return;
+        }
+        if (dirty_ == NOT_DIRTY)
+        {
+            return;
+        }
+
+        // nothing before the first edit since the last update can differ
+        auto diff = content_.mismatch(screen_, std::min(dirty_, screen_.size()));
+        dirty_ = NOT_DIRTY;
+        auto [restyle_begin, restyle_end] = std::exchange(restyled_, {NOT_DIRTY, 0});
+        if (diff == screen_.size() && diff == content_.size())
+        {
+            // the same text in other styles, only the spans that changed are painted again
+            if (restyle_begin < restyle_end)
+            {
+                repaint(restyle_begin, std::min(restyle_end, content_.size()));
+            }
+            return;
+        }
+        diff = std::min(diff, restyle_begin);
+
+        // a mark added or removed changes the cluster before it, so that one is written again too
+        if ((!clusters_.empty() || !screen_ascii_) && diff > 0)
+        {
+            diff = prevBoundary(prompt_.size() + diff) - prompt_.size();
+        }
+        moveCursor(columnAt(prompt_.size() + diff) + 1);
+        if (diff < content_.size())
+        {
+            auto style = NO_STYLE;
+            paint(diff, content_.size(), style);
+            *io_ << Color::TERMINATOR;
+        }
+        if (width() < screen_width_)
+        {
+            *io_ << "\033[K";
+            suggestion_end_ = 0;
+        }
+        screen_.resize(diff);
+        rendered();
+    }
+
+    // Draws the whole line from the first column
+    void redraw()
+    {
+        if (scrolling())
+        {
+            drawViewport();
+            return;
+        }
         *io_ << "\r";
-        *io_ << prompt_style_.str() << prompt_ << std::string(Color::TERMINATOR);
-        *io_ << content_style_.str() << content();
-        if (data_.size() < old_len_)
+        *io_ << prompt_style_.view() << prompt_ << Color::TERMINATOR;
+        auto style = NO_STYLE;
+        setStyle(Highlighter::CONTENT_STYLE, style);
+        paint(0, content_.size(), style);
+        *io_ << Color::TERMINATOR;
+        *io_ << "\033[K";
+        suggestion_end_ = 0;
+        screen_.clear();
+        rendered();
+        viewport_shown_ = false;
+    }
+
+    // Lines wider than cols (the terminal width) scroll horizontally inside it instead of wrapping,
+    // 0 lets the terminal wrap them
+    void setViewport(std::size_t cols)
+    {
+        bool was_scrolling = scrolling();
+        viewport_cols_ = cols;
+        if (was_scrolling || scrolling())
         {
-            for (std::size_t i = 0; i < (old_len_ - data_.size()); i++)
+            invalidate();
+        }
+    }
+
+    [[nodiscard]] std::size_t viewport() const
+    {
+        return viewport_cols_;
+    }
+
+    // First content column shown while the line scrolls
+    [[nodiscard]] std::size_t scrollOffset() const
+    {
+        return scrolling() ? view_ : 0;
+    }
+
+    // Moves the terminal cursor to the column (1-based) of the line relatively to where the line left
+    // it; a scrolling line maps it into the visible window, scrolled first when the column is outside
+    void moveCursor(std::size_t col)
+    {
+        if (scrolling())
+        {
+            auto column = col > prompt_width_ + 1 ? col - prompt_width_ - 1 : 0;
+            if (!isVisible(column))
+            {
+                auto half = viewportSpace() / 2;
+                view_ = column > half ? column - half : 0;
+                viewport_shown_ = false;
+            }
+            if (screen_col_ == 0 || !viewport_shown_)
             {
-                *io_ << " ";
+                drawViewport();
             }
+            col = prompt_width_ + (column - view_) + 1;
+        }
+        else if (screen_col_ == 0 || viewport_shown_)
+        {
+            redraw();
+        }
+        auto plan = CursorMotion::plan(screen_col_, col, rewriteCost(screen_col_, col));
+        if (plan.kind == CursorMotion::Kind::Rewrite)
+        {
+            rewrite(screen_col_, col);
+        }
+        else
+        {
+            CursorMotion::write(*io_, plan, screen_col_, col);
         }
-        *io_ << std::string(Color::TERMINATOR);
-        old_len_ = data_.size();
+        screen_col_ = col;
+    }
+
+    // Column of the terminal cursor as tracked from the output, 0 when unknown
+    [[nodiscard]] std::size_t screenColumn() const
+    {
+        return screen_col_;
+    }
+
+    void setScreenColumn(std::size_t col)
+    {
+        screen_col_ = col;
+    }
+
+    // Text shown dimmed after the content, e.g. the rest of a line from history, drawn on update.
+    // It is not part of the content until accepted.
+    void setSuggestion(std::string_view suggestion)
+    {
+        if (suggestion != suggestion_)
+        {
+            suggestion_.assign(suggestion);
+            suggestion_dirty_ = true;
+        }
+    }
+
+    [[nodiscard]] const std::string &suggestion() const
+    {
+        return suggestion_;
+    }
+
+    void setSuggestionStyle(const TextStyle &text_style)
+    {
+        suggestion_style_ = text_style;
+        suggestion_dirty_ = true;
+    }
+
+    // Moves the suggestion into the content
+    void acceptSuggestion()
+    {
+        append(std::exchange(suggestion_, std::string()));
+        suggestion_dirty_ = true;
+    }
+
+    // Forgets the suggestion and erases it from the screen right away, e.g. before the line is left
+    void hideSuggestion()
+    {
+        suggestion_.clear();
+        suggestion_dirty_ = false;
+        if (suggestion_end_ > 0 && screen_col_ != 0)
+        {
+            moveCursor(screen_width_ + 1);
+            *io_ << "\033[K";
+            suggestion_end_ = 0;
+        }
+    }
+
+    // Tells the line that something else wrote to the terminal, so the next update or move redraws it
+    void invalidate()
+    {
+        screen_col_ = 0;
+        suggestion_end_ = 0;
     }
 
 protected:
-    std::string data_;
+    static constexpr std::size_t NOT_DIRTY = std::string::npos;
+    static constexpr std::size_t MIN_VIEWPORT = 8;
+    static constexpr std::uint32_t NO_STYLE = UINT32_MAX;
+
     std::string prompt_;
+    std::size_t prompt_width_{0};
+    GapBuffer content_;
+    std::uint64_t revision_{0};
     TextStyle prompt_style_;
     TextStyle content_style_;
     std::shared_ptr<IO> io_;
-    std::size_t old_len_{0};
+    // What the terminal shows of the content, valid while screen_col_ is not 0
+    std::string screen_;
+    std::size_t screen_width_{0};
+    bool screen_ascii_{true};
+    std::size_t screen_col_{0};
+    // Offset of the first content byte changed since the screen was last updated
+    std::size_t dirty_{NOT_DIRTY};
+    // Horizontal scrolling: terminal width, first content column shown and whether the screen holds
+    // the visible window rather than the whole line
+    std::size_t viewport_cols_{0};
+    std::size_t view_{0};
+    bool viewport_shown_{false};
+
+    // Character clusters of content with non-ASCII text, columns counted after the prompt. All-ASCII
+    // content needs none of it.
+    std::size_t non_ascii_{0};
+    ClusterIndex clusters_;
+
+    // Styled spans of the content when a highlighter is set, and the content range whose style
+    // changed since the screen was last updated
+    std::shared_ptr<Highlighter> highlighter_;
+    SpanIndex spans_;
+    std::pair<std::size_t, std::size_t> restyled_{NOT_DIRTY, 0};
+
+    // Suggestion after the content and the screen column (1-based) right after the part of it shown,
+    // 0 when nothing of it is on the screen
+    std::string suggestion_;
+    TextStyle suggestion_style_{Color::Default, Color::Default, FontStyle::Faint};
+    std::size_t suggestion_end_{0};
+    bool suggestion_dirty_{false};
+
+    static std::size_t nonAsciiBytes(std::string_view s)
+    {
+        if (utf8::isAscii(s))
+        {
+            return 0;
+        }
+        return std::size_t(std::count_if(s.begin(), s.end(), [](char c) { return static_cast<unsigned char>(c) >= 0x80; }));
+    }
+
+    // Content columns that fit next to the prompt, the last terminal column is left empty so the
+    // terminal never wraps
+    [[nodiscard]] std::size_t viewportSpace() const
+    {
+        return viewport_cols_ > prompt_width_ + 1 ? viewport_cols_ - prompt_width_ - 1 : 0;
+    }
+
+    // Too narrow a space to scroll in (a few columns, with the markers) lets the terminal wrap
+    [[nodiscard]] bool scrolling() const
+    {
+        return viewportSpace() >= MIN_VIEWPORT && width() - prompt_width_ >= viewportSpace();
+    }
+
+    // A column under an overflow marker does not count as visible, the end of the content does
+    [[nodiscard]] bool isVisible(std::size_t column) const
+    {
+        auto space = viewportSpace();
+        auto content_width = width() - prompt_width_;
+        auto first = view_ > 0 ? view_ + 1 : view_;
+        auto last = view_ + space - (view_ + space < content_width ? 1 : 0);
+        return column >= first && column < last;
+    }
+
+    // Draws the prompt and the visible window with '<' and '>' where the content goes on
+    void drawViewport()
+    {
+        auto space = viewportSpace();
+        auto content_width = width() - prompt_width_;
+        view_ = std::min(view_, content_width > space / 2 ? content_width - space / 2 : 0);
+        auto end = view_ + space;
+        bool left = view_ > 0;
+        bool right = end < content_width;
+
+        *io_ << "\r";
+        *io_ << prompt_style_.view() << prompt_ << Color::TERMINATOR;
+        auto style = NO_STYLE;
+        setStyle(Highlighter::CONTENT_STYLE, style);
+        std::size_t cells = 0;
+        if (left)
+        {
+            *io_ << "<";
+            cells++;
+        }
+        auto first = view_ + cells;
+        auto last = end - (right ? 1 : 0);
+        if (clusters_.empty())
+        {
+            auto begin = std::min(first, content_.size());
+            auto end = std::min(last, content_.size());
+            paint(begin, end, style);
+            cells += end - begin;
+        }
+        else
+        {
+            // wide characters cut by an edge of the window are left out, their cells stay blank
+            for (auto i = clusters_.findColumn(first); i + 1 < clusters_.count() && clusters_[i + 1].column <= last; ++i)
+            {
+                auto cluster = clusters_[i];
+                auto next = clusters_[i + 1];
+                if (cluster.column - view_ > cells)
+                {
+                    setStyle(Highlighter::CONTENT_STYLE, style);
+                    writeBlank(cluster.column - view_ - cells);
+                }
+                cells = next.column - view_;
+                paint(cluster.offset, next.offset, style);
+            }
+        }
+        if (right)
+        {
+            setStyle(Highlighter::CONTENT_STYLE, style);
+            writeBlank(last - view_ - cells);
+            *io_ << ">";
+            cells = space;
+        }
+        *io_ << Color::TERMINATOR;
+        *io_ << "\033[K";
+        suggestion_end_ = 0;
+        screen_.clear();
+        screen_width_ = prompt_width_ + cells;
+        screen_ascii_ = false;
+        screen_col_ = screen_width_ + 1;
+        dirty_ = NOT_DIRTY;
+        restyled_ = {NOT_DIRTY, 0};
+        suggestion_dirty_ = true;
+        viewport_shown_ = true;
+    }
+
+    // Moving right over content shown on the screen can be done by writing it again, which is the
+    // cheapest move for a few plain characters
+    [[nodiscard]] std::size_t rewriteCost(std::size_t from, std::size_t to) const
+    {
+        if (viewport_shown_ || !screen_ascii_ || highlighter_ || to <= from || from <= prompt_width_ ||
+            to - 1 - prompt_width_ > screen_.size())
+        {
+            return CursorMotion::NO_REWRITE;
+        }
+        auto style = content_style_.view();
+        return to - from + (style.empty() ? 0 : style.size() + Color::TERMINATOR.size());
+    }
+
+    void rewrite(std::size_t from, std::size_t to)
+    {
+        auto text = std::string_view(screen_).substr(from - 1 - prompt_width_, to - from);
+        auto style = content_style_.view();
+        if (style.empty())
+        {
+            *io_ << text;
+            return;
+        }
+        *io_ << style << text << Color::TERMINATOR;
+    }
+
+    // Draws as much of the suggestion as fits before the last terminal column, nothing while the
+    // line scrolls, and erases what is left of the previous one
+    void updateSuggestion()
+    {
+        if (!suggestion_dirty_ || screen_col_ == 0)
+        {
+            return;
+        }
+        suggestion_dirty_ = false;
+
+        auto space = scrolling() ? 0 : viewport_cols_ == 0 ? suggestion_.size() :
+                     viewport_cols_ > width() + 1 ? viewport_cols_ - width() - 1 : 0;
+        std::size_t length = 0;
+        std::size_t columns = 0;
+        while (length < suggestion_.size())
+        {
+            std::size_t cluster_columns;
+            auto cluster_length = utf8::clusterLength(suggestion_, length, &cluster_columns);
+            if (columns + cluster_columns > space)
+            {
+                break;
+            }
+            length += cluster_length;
+            columns += cluster_columns;
+        }
+        if (length == 0 && suggestion_end_ <= width() + 1)
+        {
+            suggestion_end_ = 0;
+            return;
+        }
+
+        auto end = width() + 1 + columns;
+        moveCursor(width() + 1);
+        if (length > 0)
+        {
+            *io_ << suggestion_style_.view() << std::string_view(suggestion_).substr(0, length) << Color::TERMINATOR;
+        }
+        if (suggestion_end_ > end)
+        {
+            *io_ << "\033[K";
+        }
+        screen_col_ = end;
+        suggestion_end_ = length > 0 ? end : 0;
+    }
+
+    [[nodiscard]] const TextStyle &styleOf(std::uint32_t index) const
+    {
+        const TextStyle *style = highlighter_ ? highlighter_->style(index) : nullptr;
+        return style ? *style : content_style_;
+    }
+
+    // Switches the terminal to the style, current is the one written last (NO_STYLE for none)
+    void setStyle(std::uint32_t index, std::uint32_t &current)
+    {
+        if (index == current)
+        {
+            return;
+        }
+        if (current != NO_STYLE && !styleOf(current).view().empty())
+        {
+            *io_ << Color::TERMINATOR;
+        }
+        *io_ << styleOf(index).view();
+        current = index;
+    }
+
+    // Writes content [from, to) in the styles of its spans, a style only where it changes
+    void paint(std::size_t from, std::size_t to, std::uint32_t &style)
+    {
+        if (!highlighter_)
+        {
+            setStyle(Highlighter::CONTENT_STYLE, style);
+            writeContent(from, to);
+            return;
+        }
+        spans_.visit(from, to, [this, &style](std::size_t begin, std::size_t end, std::uint32_t index) {
+            setStyle(index, style);
+            writeContent(begin, end);
+        });
+    }
+
+    void writeContent(std::size_t from, std::size_t to)
+    {
+        auto [before, after] = content_.pieces(from);
+        before = before.substr(0, to - from);
+        after = after.substr(0, to - from - before.size());
+        *io_ << before << after;
+    }
+
+    // Paints content [from, to) again where it is, for text that only changed its style
+    void repaint(std::size_t from, std::size_t to)
+    {
+        if (!clusters_.empty())
+        {
+            from = prevBoundary(prompt_.size() + from + 1) - prompt_.size();
+            to = to > from ? nextBoundary(prompt_.size() + to - 1) - prompt_.size() : from;
+        }
+        if (from >= to)
+        {
+            return;
+        }
+        moveCursor(columnAt(prompt_.size() + from) + 1);
+        auto style = NO_STYLE;
+        paint(from, to, style);
+        *io_ << Color::TERMINATOR;
+        screen_col_ = columnAt(prompt_.size() + to) + 1;
+    }
+
+    void writeBlank(std::size_t cells)
+    {
+        constexpr std::string_view BLANK = "                ";
+        for (; cells > 0; cells -= std::min(cells, BLANK.size()))
+        {
+            *io_ << BLANK.substr(0, cells);
+        }
+    }
+
+    void rendered()
+    {
+        auto [before, after] = content_.pieces(screen_.size());
+        screen_.append(before).append(after);
+        screen_ascii_ = clusters_.empty();
+        screen_width_ = width();
+        screen_col_ = screen_width_ + 1;
+        dirty_ = NOT_DIRTY;
+        restyled_ = {NOT_DIRTY, 0};
+        suggestion_dirty_ = true;
+    }
+
+    // Lexes again the tokens around the edit, the content whose style changed is painted on update
+    void highlight(std::size_t from, std::size_t new_end)
+    {
+        auto [begin, end] = spans_.edited(*highlighter_, from, new_end, content_.size(),
+                                          [this](std::size_t pos) { return content_.view(pos); });
+        if (begin < end)
+        {
+            restyled_.first = std::min(restyled_.first, begin);
+            restyled_.second = std::max(restyled_.second, end);
+        }
+    }
+
+    // Length of the cluster at offset, read through a window around it so the gap moves only a little
+    [[nodiscard]] std::size_t clusterLength(std::size_t offset, std::size_t *columns) const
+    {
+        for (std::size_t span = 64;; span *= 2)
+        {
+            auto end = std::min(content_.size(), offset + span);
+            auto text = content_.view(offset, end);
+            auto length = utf8::clusterLength(text, 0, columns);
+            // the character after the cluster has to be in the window to tell where the cluster ends
+            if (length + 4 <= text.size() || end == content_.size())
+            {
+                return length;
+            }
+        }
+    }
+
+    // Content from offset from was replaced with [from, new_end): only clusters around the edit are
+    // scanned again, the ones after it stay as they are
+    void edited(std::size_t from, std::size_t new_end)
+    {
+        revision_++;
+        // an edit inside a character may make it another one, it is scanned again from its first byte
+        while (from > 0 && from < content_.size() && utf8::isContinuation(static_cast<unsigned char>(content_[from])))
+        {
+            from--;
+        }
+        dirty_ = std::min(dirty_, from);
+        if (highlighter_)
+        {
+            highlight(from, new_end);
+        }
+        if (non_ascii_ == 0)
+        {
+            clusters_.clear();
+            return;
+        }
+        if (clusters_.empty())
+        {
+            // the first non-ASCII character, everything gets indexed
+            from = 0;
+            new_end = content_.size();
+        }
+        clusters_.edited(from, new_end, content_.size(),
+                         [this](std::size_t pos, std::size_t *columns) { return clusterLength(pos, columns); });
+    }
 }; /* End of class Line */
 
 } /* End of namespace cmdly */
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_MOTION_H
+#define CMDLY_MOTION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <cmdly/io.h>
+
+namespace cmdly {
+
+// Picks the cheapest way to move the terminal cursor along the row, in the spirit of curses' mvcur:
+// every sequence that gets there is priced in bytes and the shortest one wins, relative moves on a
+// tie. Nothing depends on the row, so a line never needs to know where on the screen it is.
+class CursorMotion
+{
+public:
+    enum class Kind
+    {
+        None,
+        Backward,       // ESC[nD
+        Backspaces,     // \b repeated
+        Forward,        // ESC[nC
+        Rewrite,        // the characters in between written again, done by the caller
+        HomeForward,    // \r and ESC[nC
+        Column          // ESC[nG
+    };
+
+    struct Plan
+    {
+        Kind kind;
+        std::size_t cost;
+    };
+
+    static constexpr std::size_t NO_REWRITE = SIZE_MAX;
+
+    // Moving from column to column (both 1-based); rewrite_cost is the price of writing again what
+    // is between them, NO_REWRITE when that is not known
+    static constexpr Plan plan(std::size_t from, std::size_t to, std::size_t rewrite_cost = NO_REWRITE)
+    {
+        if (from == to)
+        {
+            return {Kind::None, 0};
+        }
+
+        Plan best = to < from ? Plan{Kind::Backward, relativeCost(from - to)} : Plan{Kind::Forward, relativeCost(to - from)};
+        auto consider = [&best](Kind kind, std::size_t cost) {
+            if (cost < best.cost)
+            {
+                best = {kind, cost};
+            }
+        };
+        if (to < from)
+        {
+            consider(Kind::Backspaces, from - to);
+        }
+        else
+        {
+            consider(Kind::Rewrite, rewrite_cost);
+        }
+        consider(Kind::HomeForward, 1 + relativeCost(to - 1));
+        consider(Kind::Column, to == 1 ? 3 : 3 + digits(to));
+        return best;
+    }
+
+    // Writes the plan, except for Rewrite which only the caller knows how to do
+    static void write(IO &io, const Plan &plan, std::size_t from, std::size_t to)
+    {
+        switch (plan.kind)
+        {
+        case Kind::Backward:
+            relative(io, from - to, "D");
+            break;
+        case Kind::Backspaces:
+            for (auto n = from - to; n > 0; n -= std::min<std::size_t>(n, BACKSPACES.size()))
+            {
+                io << BACKSPACES.substr(0, n);
+            }
+            break;
+        case Kind::Forward:
+            relative(io, to - from, "C");
+            break;
+        case Kind::HomeForward:
+            io << "\r";
+            relative(io, to - 1, "C");
+            break;
+        case Kind::Column:
+            io << "\033[";
+            if (to != 1)
+            {
+                io << std::uint32_t(to);
+            }
+            io << "G";
+            break;
+        default:
+            break;
+        }
+    }
+
+    // ESC[C moves by one, the count is written only above that
+    static constexpr std::size_t relativeCost(std::size_t n)
+    {
+        return n == 0 ? 0 : n == 1 ? 3 : 3 + digits(n);
+    }
+
+private:
+    static constexpr std::string_view BACKSPACES = "\b\b\b\b\b\b\b\b";
+
+    static constexpr std::size_t digits(std::size_t n)
+    {
+        std::size_t count = 1;
+        for (; n >= 10; n /= 10)
+        {
+            count++;
+        }
+        return count;
+    }
+
+    static void relative(IO &io, std::size_t n, const char *final_byte)
+    {
+        if (n == 0)
+        {
+            return;
+        }
+        io << "\033[";
+        if (n != 1)
+        {
+            io << std::uint32_t(n);
+        }
+        io << final_byte;
+    }
+}; /* End of class CursorMotion */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_MOTION_H */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_QUEUE_H
+#define CMDLY_QUEUE_H
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace cmdly {
+
+// Lock-free multi-producer single-consumer queue (intrusive list with a stub node).
+// push() is a single atomic exchange and never blocks, pop() must be called from one thread only.
+template<typename T>
+class MpscQueue
+{
+public:
+    MpscQueue() :
+        head_(new Node()), tail_(head_.load())
+    {}
+
+    ~MpscQueue()
+    {
+        while (pop())
+        {}
+        delete tail_;
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    void push(T value)
+    {
+        auto *node = new Node(std::move(value));
+        auto *prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Nothing is returned when the queue is empty, or while the next producer has not finished linking its node
+    std::optional<T> pop()
+    {
+        auto *next = tail_->next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return std::nullopt;
+        }
+        auto value = std::move(next->value);
+        delete tail_;
+        tail_ = next;
+        return value;
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};
+        T value;
+
+        Node() = default;
+
+        explicit Node(T value_) :
+            value(std::move(value_))
+        {}
+    };
+
+    std::atomic<Node *> head_;
+    Node *tail_;
+}; /* End of class MpscQueue */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_QUEUE_H */
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_RADIX_TREE_H
+#define CMDLY_RADIX_TREE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cmdly {
+
+// Radix tree with a value in every node: an edge holds the whole run of characters shared by the
+// keys below it, so a long key costs a node or two. The nodes sit in one vector and are found by
+// position, so clearing the tree recurses nowhere and erased nodes are taken again before it grows.
+template<typename Value>
+class RadixTree
+{
+public:
+    static constexpr std::size_t NONE = SIZE_MAX;
+
+    RadixTree() :
+        nodes_(1)
+    {}
+
+    // Adds the nodes the key needs and appends to path the ones from the root to where it ends. A
+    // node put in the middle of an edge gets split(value of the node below it) for its value.
+    template<typename Split>
+    void insert(std::string_view key, std::vector<std::size_t> &path, Split &&split)
+    {
+        std::size_t node = 0;
+        path.push_back(node);
+        for (std::size_t pos = 0; pos < key.size();)
+        {
+            // nodes are added below, so children are found by position rather than kept by iterator
+            auto slot = std::size_t(childAt(node, key[pos]) - nodes_[node].children.begin());
+            if (slot == nodes_[node].children.size() || nodes_[nodes_[node].children[slot]].label[0] != key[pos])
+            {
+                auto leaf = add(std::string(key.substr(pos)));
+                nodes_[node].children.insert(nodes_[node].children.begin() + std::ptrdiff_t(slot), std::uint32_t(leaf));
+                path.push_back(leaf);
+                return;
+            }
+            std::size_t child = nodes_[node].children[slot];
+            const auto &label = nodes_[child].label;
+            auto rest = key.substr(pos);
+            auto length = std::min(label.size(), rest.size());
+            auto common = std::size_t(std::mismatch(label.begin(), label.begin() + std::ptrdiff_t(length), rest.begin()).first -
+                                      label.begin());
+            if (common < label.size())
+            {
+                // the edge is split where the key leaves it
+                auto middle = add(label.substr(0, common));
+                nodes_[child].label.erase(0, common);
+                nodes_[middle].children.push_back(std::uint32_t(child));
+                nodes_[middle].value = split(std::as_const(nodes_[child].value));
+                nodes_[node].children[slot] = std::uint32_t(middle);
+                child = middle;
+            }
+            node = child;
+            path.push_back(node);
+            pos += common;
+        }
+    }
+
+    // Appends to path the nodes from the root down to where key ends, false when it does not end at a node
+    bool walk(std::string_view key, std::vector<std::size_t> &path) const
+    {
+        path.push_back(0);
+        for (std::size_t pos = 0; pos < key.size();)
+        {
+            auto node = path.back();
+            auto it = childAt(node, key[pos]);
+            if (it == nodes_[node].children.end() || nodes_[*it].label[0] != key[pos])
+            {
+                return false;
+            }
+            auto &label = nodes_[*it].label;
+            if (key.compare(pos, label.size(), label) != 0)
+            {
+                return false;
+            }
+            pos += label.size();
+            path.push_back(*it);
+        }
+        return true;
+    }
+
+    // The node of the edge where phrase ends, NONE when no key starts with it; depth gets the length
+    // of the path to the node, which is more than the phrase when it ends inside the edge
+    std::size_t descend(std::string_view phrase, std::size_t &depth) const
+    {
+        std::size_t node = 0;
+        depth = 0;
+        while (depth < phrase.size())
+        {
+            auto it = childAt(node, phrase[depth]);
+            if (it == nodes_[node].children.end() || nodes_[*it].label[0] != phrase[depth])
+            {
+                return NONE;
+            }
+            auto &label = nodes_[*it].label;
+            auto length = std::min(label.size(), phrase.size() - depth);
+            if (phrase.compare(depth, length, label, 0, length) != 0)
+            {
+                return NONE;
+            }
+            depth += label.size();
+            node = *it;
+        }
+        return node;
+    }
+
+    // Calls visit(node, path) for the node and the nodes below it in order, path being the characters
+    // on the way to each of them
+    template<typename Visit>
+    void visit(std::size_t node, std::string &path, Visit &&visit) const
+    {
+        visit(node, static_cast<const std::string &>(path));
+        for (auto child : nodes_[node].children)
+        {
+            auto length = path.size();
+            path += nodes_[child].label;
+            this->visit(child, path, visit);
+            path.resize(length);
+        }
+    }
+
+    // Frees the child of the node with everything below it
+    void erase(std::size_t node, std::size_t child)
+    {
+        auto &children = nodes_[node].children;
+        children.erase(std::find(children.begin(), children.end(), std::uint32_t(child)));
+        std::vector<std::size_t> pending{child};
+        while (!pending.empty())
+        {
+            auto next = pending.back();
+            pending.pop_back();
+            pending.insert(pending.end(), nodes_[next].children.begin(), nodes_[next].children.end());
+            nodes_[next] = Node();
+            free_.push_back(next);
+        }
+    }
+
+    // The node takes in its only child, whose label and value it gets
+    void join(std::size_t node)
+    {
+        auto child = nodes_[node].children.front();
+        nodes_[node].label += nodes_[child].label;
+        nodes_[node].children = std::move(nodes_[child].children);
+        nodes_[node].value = std::move(nodes_[child].value);
+        nodes_[child] = Node();
+        free_.push_back(child);
+    }
+
+    [[nodiscard]] Value &operator[](std::size_t node)
+    {
+        return nodes_[node].value;
+    }
+
+    [[nodiscard]] const Value &operator[](std::size_t node) const
+    {
+        return nodes_[node].value;
+    }
+
+    [[nodiscard]] const std::string &label(std::size_t node) const
+    {
+        return nodes_[node].label;
+    }
+
+    // Ordered by the first character of their labels, the way std::string compares them
+    [[nodiscard]] const std::vector<std::uint32_t> &children(std::size_t node) const
+    {
+        return nodes_[node].children;
+    }
+
+    void clear()
+    {
+        nodes_.assign(1, Node());
+        free_.clear();
+    }
+
+private:
+    struct Node
+    {
+        std::string label;
+        std::vector<std::uint32_t> children;
+        Value value{};
+    };
+
+    std::vector<Node> nodes_;
+    // slots of erased nodes
+    std::vector<std::size_t> free_;
+
+    std::size_t add(std::string label)
+    {
+        std::size_t node;
+        if (free_.empty())
+        {
+            node = nodes_.size();
+            nodes_.emplace_back();
+        }
+        else
+        {
+            node = free_.back();
+            free_.pop_back();
+        }
+        nodes_[node].label = std::move(label);
+        return node;
+    }
+
+    // The child whose label starts with c, or where it would go
+    [[nodiscard]] typename std::vector<std::uint32_t>::const_iterator childAt(std::size_t node, char c) const
+    {
+        auto &children = nodes_[node].children;
+        return std::lower_bound(children.begin(), children.end(), c, [this](std::uint32_t child, char value) {
+            return std::uint8_t(nodes_[child].label[0]) < std::uint8_t(value);
+        });
+    }
+}; /* End of class RadixTree */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_RADIX_TREE_H */
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_REACTOR_H
+#define CMDLY_REACTOR_H
+
+#include <sys/epoll.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <cmdly/exception.h>
+
+namespace cmdly {
+
+// Minimal epoll-based event loop shared by a terminal and the application
+class Reactor
+{
+public:
+    using Handler = std::function<void(std::uint32_t events)>;
+    using TimerHandler = std::function<void()>;
+
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor &) = delete;
+    Reactor &operator=(const Reactor &) = delete;
+
+    void add(int fd, std::uint32_t events, const Handler &handler);
+    void modify(int fd, std::uint32_t events);
+    void remove(int fd);
+    [[nodiscard]] bool contains(int fd) const;
+
+    // Creates a timerfd firing after delay, and then every interval if it is non-zero
+    int addTimer(std::chrono::milliseconds delay, std::chrono::milliseconds interval, const TimerHandler &handler);
+    void removeTimer(int fd);
+
+    // Waits up to timeout (negative means forever) and dispatches ready events, returns their number
+    std::size_t poll(std::chrono::milliseconds timeout = std::chrono::milliseconds(-1));
+
+    [[nodiscard]] int descriptor() const
+    {
+        return epoll_fd_;
+    }
+
+private:
+    static constexpr int MAX_EVENTS = 64;
+
+    int epoll_fd_;
+    std::unordered_map<int, std::shared_ptr<Handler>> handlers_;
+}; /* End of class Reactor */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_REACTOR_H */
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_RECORDING_H
+#define CMDLY_RECORDING_H
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cmdly/io.h>
+
+namespace cmdly {
+
+// One entry of a recorded session
+struct SessionEvent
+{
+    enum class Type : std::uint8_t
+    {
+        Input = 1,
+        Output = 2,
+        Resize = 3,
+    };
+
+    std::chrono::nanoseconds time;  // since the session started
+    Type type;
+    std::string data;               // bytes, or the window size for Resize
+}; /* End of struct SessionEvent */
+
+// Binary session log: a header, then for every event its time, type, length and data (host byte order)
+class SessionLog
+{
+public:
+    static constexpr std::string_view MAGIC = "CMDLYSES";
+    static constexpr std::uint8_t VERSION = 1;
+
+    struct Header
+    {
+        bool interactive{true};
+    };
+
+    static void writeHeader(std::ostream &out, const Header &header);
+    static void writeEvent(std::ostream &out, const SessionEvent &event);
+    // Throws IOError when the file can't be read or is not a session log
+    static std::vector<SessionEvent> load(const std::string &path, Header *header = nullptr);
+
+    static std::string encodeSize(std::size_t cols, std::size_t rows);
+    static void decodeSize(std::string_view data, std::size_t *cols, std::size_t *rows);
+}; /* End of class SessionLog */
+
+// Decorator logging everything going through another IO, so a session can be replayed later
+class RecordingIO : public IO
+{
+public:
+    RecordingIO(std::shared_ptr<IO> io, const std::string &path);
+
+    Key getKey() override;
+    char getChar() override;
+    void write(const std::string &data) const override;
+    void getWindowSize(std::size_t *cols, std::size_t *rows) const override;
+    void enterRawMode() override;
+    void exitRawMode() override;
+    [[nodiscard]] bool isInteractive() const override;
+    [[nodiscard]] int inputDescriptor() const override;
+    bool waitForInput(std::chrono::milliseconds timeout) override;
+    std::optional<std::string> readAvailable() override;
+    [[nodiscard]] int resizeDescriptor() const override;
+    bool checkResize() override;
+
+private:
+    std::shared_ptr<IO> io_;
+    mutable std::ofstream log_;
+    std::chrono::steady_clock::time_point start_;
+
+    void record(SessionEvent::Type type, std::string_view data) const;
+    void recordSize();
+}; /* End of class RecordingIO */
+
+// Feeds a recorded session back, at the original pace or as fast as it can be processed
+class ReplayIO : public IO
+{
+public:
+    enum class Speed
+    {
+        Original,
+        Fastest,
+    };
+
+    // Processing of one key (or chunk of input): from handing it out until the next one is asked for
+    struct Timing
+    {
+        std::size_t event;
+        std::chrono::nanoseconds time;
+        std::chrono::nanoseconds processing;
+        std::size_t output_bytes;
+    };
+
+    explicit ReplayIO(const std::string &path, Speed speed = Speed::Fastest);
+
+    Key getKey() override;
+    char getChar() override;
+    void write(const std::string &data) const override;
+    void getWindowSize(std::size_t *cols, std::size_t *rows) const override;
+    [[nodiscard]] bool isInteractive() const override;
+    bool waitForInput(std::chrono::milliseconds timeout) override;
+    std::optional<std::string> readAvailable() override;
+
+    [[nodiscard]] const std::vector<SessionEvent> &events() const
+    {
+        return events_;
+    }
+
+    // Call once the terminal is done, so the last key gets its timing too
+    const std::vector<Timing> &timings();
+
+    [[nodiscard]] bool finished() const;
+
+private:
+    std::vector<SessionEvent> events_;
+    std::size_t next_event_{0};
+    std::size_t current_event_{0};
+    Speed speed_;
+    bool interactive_{true};
+    KeyDecoder decoder_;
+    std::size_t cols_{80};
+    std::size_t rows_{24};
+    std::chrono::steady_clock::time_point start_;
+    std::vector<Timing> timings_;
+    bool timing_{false};
+    std::chrono::steady_clock::time_point timing_begin_;
+    mutable std::size_t output_bytes_{0};
+
+    const SessionEvent *nextInput();
+    void beginTiming();
+    void endTiming();
+}; /* End of class ReplayIO */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_RECORDING_H */
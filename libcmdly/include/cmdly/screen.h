@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_SCREEN_H
+#define CMDLY_SCREEN_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include <cmdly/io.h>
+#include <cmdly/motion.h>
+#include <cmdly/style.h>
+#include <cmdly/utf8.h>
+
+namespace cmdly {
+
+// Rectangle of character cells kept in two buffers: the back one holds what should be on the screen,
+// the front one what is there. Changes go to the back buffer and mark the cells of their row as
+// damaged, flush() compares just the damaged cells and writes the ones that differ.
+class CellGrid
+{
+public:
+    using StyleIndex = std::uint8_t;
+
+    struct Cell
+    {
+        // one character cluster, no bytes for the cell under the right half of a wide character
+        std::array<char, 12> text{' '};
+        std::uint8_t length{1};
+        StyleIndex style{0};
+
+        bool operator==(const Cell &cell) const
+        {
+            return length == cell.length && style == cell.style &&
+                   std::memcmp(text.data(), cell.text.data(), length) == 0;
+        }
+
+        [[nodiscard]] std::string_view view() const
+        {
+            return {text.data(), length};
+        }
+
+        [[nodiscard]] bool isBlank() const
+        {
+            return length == 1 && text[0] == ' ' && style == 0;
+        }
+    };
+
+    CellGrid() :
+        styles_{TextStyle::Default}
+    {}
+
+    // Both buffers are blank afterwards, the region of the screen has to be blank too
+    void resize(std::size_t rows, std::size_t cols)
+    {
+        rows_ = rows;
+        cols_ = cols;
+        back_.assign(rows * cols, Cell());
+        front_ = back_;
+        damage_.assign(rows, {cols, 0});
+    }
+
+    [[nodiscard]] std::size_t rows() const
+    {
+        return rows_;
+    }
+
+    [[nodiscard]] std::size_t cols() const
+    {
+        return cols_;
+    }
+
+    // Style 0 is the default one
+    StyleIndex addStyle(const TextStyle &style)
+    {
+        styles_.push_back(style);
+        return StyleIndex(styles_.size() - 1);
+    }
+
+    // Writes text into the back buffer from (row, col) on, cut at the end of the row; returns the
+    // columns taken
+    std::size_t put(std::size_t row, std::size_t col, std::string_view text, StyleIndex style = 0)
+    {
+        if (row >= rows_ || col >= cols_)
+        {
+            return 0;
+        }
+        auto begin = col;
+        // half of a wide character left alone becomes blank
+        if (cell(row, col).length == 0 && col > 0)
+        {
+            set(row, col - 1, Cell());
+        }
+        for (std::size_t pos = 0; pos < text.size();)
+        {
+            std::size_t columns;
+            auto length = utf8::clusterLength(text, pos, &columns);
+            if (columns == 0 || col + columns > cols_)
+            {
+                break;
+            }
+            Cell c;
+            c.length = std::uint8_t(std::min(length, c.text.size()));
+            if (length > c.text.size())
+            {
+                // a cluster too long for a cell keeps its first character only
+                utf8::decode(text, pos, &length);
+                c.length = std::uint8_t(length);
+            }
+            std::memcpy(c.text.data(), text.data() + pos, c.length);
+            c.style = style;
+            set(row, col, c);
+            if (columns == 2)
+            {
+                Cell tail;
+                tail.length = 0;
+                tail.style = style;
+                set(row, col + 1, tail);
+            }
+            col += columns;
+            pos += length;
+        }
+        if (col < cols_ && cell(row, col).length == 0)
+        {
+            set(row, col, Cell());
+        }
+        return col - begin;
+    }
+
+    // Blanks count cells from (row, col) on
+    void erase(std::size_t row, std::size_t col, std::size_t count)
+    {
+        for (auto end = std::min(col + count, cols_); row < rows_ && col < end; ++col)
+        {
+            set(row, col, Cell());
+        }
+    }
+
+    // Blanks the back buffer, flushing it then erases from the screen what was drawn
+    void clear()
+    {
+        for (std::size_t row = 0; row < rows_; ++row)
+        {
+            erase(row, 0, cols_);
+        }
+    }
+
+    [[nodiscard]] bool isDamaged() const
+    {
+        return std::any_of(damage_.begin(), damage_.end(), [](const auto &range) { return range.first < range.second; });
+    }
+
+    // Writes the cells of the back buffer that differ from the front one. The grid starts top rows
+    // below the row of the terminal cursor, which is saved and restored around the drawing.
+    void flush(IO &io, std::size_t top = 1)
+    {
+        if (!isDamaged())
+        {
+            return;
+        }
+        io << "\0337";
+        std::size_t row = 0;
+        std::size_t col = 0;    // 1-based, 0 while unknown
+        bool moved = false;
+        auto style = NO_STYLE;
+        for (std::size_t r = 0; r < rows_; ++r)
+        {
+            auto [begin, end] = damage_[r];
+            damage_[r] = {cols_, 0};
+            // a blank end of the row is erased at once
+            auto blank = cols_;
+            while (blank > begin && cell(r, blank - 1).isBlank())
+            {
+                blank--;
+            }
+            for (auto c = begin; c < end; ++c)
+            {
+                bool erase = c >= blank;
+                if (erase ? !eraseNeeded(r, c, end) : cell(r, c) == front(r, c))
+                {
+                    if (erase)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+                // down to the row, then along it
+                auto down = moved ? r - row : top + r;
+                if (down > 0)
+                {
+                    io << "\033[";
+                    if (down != 1)
+                    {
+                        io << std::uint32_t(down);
+                    }
+                    io << "B";
+                }
+                row = r;
+                moved = true;
+                moveTo(io, col, c + 1, r, style);
+                if (erase)
+                {
+                    setStyle(io, 0, style);
+                    io << "\033[K";
+                    std::copy(back_.begin() + std::ptrdiff_t(index(r, c)), back_.begin() + std::ptrdiff_t(index(r, cols_)),
+                              front_.begin() + std::ptrdiff_t(index(r, c)));
+                    col = c + 1;
+                    break;
+                }
+                setStyle(io, cell(r, c).style, style);
+                io << cell(r, c).view();
+                front(r, c) = cell(r, c);
+                col = c + 2;
+                if (c + 1 < cols_ && cell(r, c + 1).length == 0)
+                {
+                    front(r, c + 1) = cell(r, c + 1);
+                    col++;
+                    c++;
+                }
+            }
+        }
+        if (style != NO_STYLE && style != 0)
+        {
+            io << Color::TERMINATOR;
+        }
+        io << "\0338";
+    }
+
+private:
+    static constexpr StyleIndex NO_STYLE = 0xFF;
+
+    std::size_t rows_{0};
+    std::size_t cols_{0};
+    std::vector<Cell> back_;
+    std::vector<Cell> front_;
+    // Cells [first, second) of a row changed since the last flush
+    std::vector<std::pair<std::size_t, std::size_t>> damage_;
+    std::vector<TextStyle> styles_;
+
+    [[nodiscard]] std::size_t index(std::size_t row, std::size_t col) const
+    {
+        return row * cols_ + col;
+    }
+
+    [[nodiscard]] const Cell &cell(std::size_t row, std::size_t col) const
+    {
+        return back_[index(row, col)];
+    }
+
+    Cell &front(std::size_t row, std::size_t col)
+    {
+        return front_[index(row, col)];
+    }
+
+    void set(std::size_t row, std::size_t col, const Cell &c)
+    {
+        auto &target = back_[index(row, col)];
+        if (target == c)
+        {
+            return;
+        }
+        target = c;
+        damage_[row].first = std::min(damage_[row].first, col);
+        damage_[row].second = std::max(damage_[row].second, col + 1);
+    }
+
+    // Something is left on the screen in the blank end of the row
+    [[nodiscard]] bool eraseNeeded(std::size_t row, std::size_t col, std::size_t end)
+    {
+        for (; col < end; ++col)
+        {
+            if (!(front(row, col) == cell(row, col)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Moves along the row from column from (0 when unknown) to column to, writing again the cells
+    // in between when that is the cheapest
+    void moveTo(IO &io, std::size_t from, std::size_t to, std::size_t row, StyleIndex &style)
+    {
+        if (from == 0)
+        {
+            CursorMotion::write(io, {CursorMotion::Kind::Column, 0}, 0, to);
+            return;
+        }
+        auto rewrite_cost = to > from ? to - from : CursorMotion::NO_REWRITE;
+        for (auto c = from - 1; c + 1 < to && rewrite_cost != CursorMotion::NO_REWRITE; ++c)
+        {
+            if (cell(row, c).style != style || cell(row, c).length != 1)
+            {
+                rewrite_cost = CursorMotion::NO_REWRITE;
+            }
+        }
+        auto plan = CursorMotion::plan(from, to, rewrite_cost);
+        if (plan.kind != CursorMotion::Kind::Rewrite)
+        {
+            CursorMotion::write(io, plan, from, to);
+            return;
+        }
+        for (auto c = from - 1; c + 1 < to; ++c)
+        {
+            io << cell(row, c).view();
+        }
+    }
+
+    void setStyle(IO &io, StyleIndex index, StyleIndex &current)
+    {
+        if (index == current)
+        {
+            return;
+        }
+        if (current != NO_STYLE && !styles_[current].view().empty())
+        {
+            io << Color::TERMINATOR;
+        }
+        io << styles_[index].view();
+        current = index;
+    }
+}; /* End of class CellGrid */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_SCREEN_H */
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_SERVER_H
+#define CMDLY_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <cmdly/decoder.h>
+#include <cmdly/io.h>
+#include <cmdly/reactor.h>
+#include <cmdly/terminal.h>
+
+namespace cmdly {
+
+// IO of one remote session over a connected non-blocking socket, the socket is closed with it.
+// Writes never block the thread serving the session: what the peer does not take is kept (up to
+// OUTPUT_LIMIT) and sent by flushPending(), a peer not reading at all gets disconnected.
+class SocketIO : public IO
+{
+public:
+    static constexpr std::size_t OUTPUT_LIMIT = 256 * 1024;
+
+    explicit SocketIO(int fd, std::size_t cols = 80, std::size_t rows = 24);
+    ~SocketIO() override;
+
+    SocketIO(const SocketIO &) = delete;
+    SocketIO &operator=(const SocketIO &) = delete;
+
+    // Sessions are fed by the reactor, these block until the peer sends something
+    Key getKey() override;
+    char getChar() override;
+
+    // The peer is expected to be a terminal in raw mode (e.g. `socat -,raw,echo=0 UNIX-CONNECT:path`)
+    [[nodiscard]] bool isInteractive() const override
+    {
+        return true;
+    }
+
+    [[nodiscard]] int inputDescriptor() const override
+    {
+        return fd_;
+    }
+
+    std::optional<std::string> readAvailable() override;
+
+    void write(const std::string &data) const override;
+    void getWindowSize(std::size_t *cols, std::size_t *rows) const override;
+    void setWindowSize(std::size_t cols, std::size_t rows);
+
+    // Sends kept output, true when nothing is left
+    bool flushPending();
+
+    [[nodiscard]] bool hasPending() const
+    {
+        return !pending_.empty();
+    }
+
+    // Called when output starts being kept because the socket is full
+    void onBlocked(const std::function<void()> &handler)
+    {
+        blocked_handler_ = handler;
+    }
+
+private:
+    static constexpr std::size_t READ_BUFFER_SIZE = 4096;
+    // how long the rest of an escape sequence is waited for by getKey()
+    static constexpr std::chrono::milliseconds ESC_TIMEOUT{100};
+
+    int fd_;
+    std::size_t cols_;
+    std::size_t rows_;
+    KeyDecoder decoder_;
+    mutable std::string pending_;
+    std::function<void()> blocked_handler_;
+
+    bool send(std::string_view data) const;
+    bool waitInput(std::chrono::milliseconds timeout) const;
+    bool fill();
+}; /* End of class SocketIO */
+
+// Serves one Terminal per connection on a Unix domain socket. Sessions are spread over a few
+// worker threads, each running its own reactor; a worker owns the sessions it accepted.
+class SessionServer
+{
+public:
+    // Sets up listeners, completion etc. of a new session, called on the worker thread serving it
+    using SetupHandler = std::function<void(Terminal &)>;
+
+    struct Options
+    {
+        std::size_t threads{2};
+        std::string prompt{"> "};
+        std::size_t history_limit{32};
+        std::size_t max_sessions{65536};
+    };
+
+    SessionServer(std::string path, SetupHandler setup, Options options);
+    SessionServer(std::string path, SetupHandler setup);
+    ~SessionServer();
+
+    SessionServer(const SessionServer &) = delete;
+    SessionServer &operator=(const SessionServer &) = delete;
+
+    void start();
+    void stop();
+
+    [[nodiscard]] std::size_t sessions() const
+    {
+        return session_count_.load();
+    }
+
+    [[nodiscard]] const std::string &path() const
+    {
+        return path_;
+    }
+
+private:
+    struct Session
+    {
+        std::shared_ptr<SocketIO> io;
+        std::unique_ptr<Terminal> terminal;
+        // duplicate of the socket watched for room to write while output is kept, -1 otherwise
+        int writable{-1};
+    };
+
+    struct Worker
+    {
+        std::shared_ptr<Reactor> reactor;
+        std::thread thread;
+        std::unordered_map<int, Session> sessions;
+        std::vector<int> closed;
+    };
+
+    std::string path_;
+    SetupHandler setup_;
+    Options options_;
+    int listen_fd_{-1};
+    std::atomic<bool> running_{false};
+    std::atomic<std::size_t> session_count_{0};
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    void serve(Worker &worker);
+    void accept(Worker &worker);
+    void watchOutput(Worker &worker, int fd);
+    static void unwatchOutput(Worker &worker, Session &session);
+    void closeSessions(Worker &worker);
+}; /* End of class SessionServer */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_SERVER_H */
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#ifndef CMDLY_SPLIT_INDEX_H
+#define CMDLY_SPLIT_INDEX_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace cmdly {
+
+// Items at offsets of content being edited, split at the last edit: the ones before it with offsets
+// from the beginning, the ones after it in reverse and counted back from the end, so an edit leaves
+// the items after it as they are. An item has an offset and gives item.mirrored(end), itself counted
+// from the other end, where end is the item at the end of the content.
+template<typename T>
+class SplitIndex
+{
+public:
+    void clear()
+    {
+        before_.clear();
+        after_.clear();
+        end_ = T{};
+    }
+
+    [[nodiscard]] bool empty() const
+    {
+        return before_.empty() && after_.empty();
+    }
+
+    [[nodiscard]] std::size_t count() const
+    {
+        return before_.size() + after_.size();
+    }
+
+    [[nodiscard]] T operator[](std::size_t index) const
+    {
+        if (index < before_.size())
+        {
+            return before_[index];
+        }
+        return after_[after_.size() - 1 - (index - before_.size())].mirrored(end_);
+    }
+
+    // Items starting at offset or before it
+    [[nodiscard]] std::size_t upperBound(std::size_t offset) const
+    {
+        auto it = std::upper_bound(before_.begin(), before_.end(), offset,
+                                   [](std::size_t value, const T &item) { return value < item.offset; });
+        if (it != before_.end() || after_.empty())
+        {
+            return std::size_t(it - before_.begin());
+        }
+        // the items after the gap starting past offset are the first ones in reverse
+        auto past = std::size_t(std::lower_bound(after_.begin(), after_.end(), end_.offset - offset,
+                                                 [](const T &item, std::size_t value) { return item.offset < value; }) -
+                                after_.begin());
+        return count() - past;
+    }
+
+    // Moves the gap so that the items starting before offset are the ones before it
+    void moveGap(std::size_t offset)
+    {
+        while (!before_.empty() && before_.back().offset >= offset)
+        {
+            after_.push_back(before_.back().mirrored(end_));
+            before_.pop_back();
+        }
+        while (!after_.empty() && end_.offset - after_.back().offset < offset)
+        {
+            before_.push_back(after_.back().mirrored(end_));
+            after_.pop_back();
+        }
+    }
+
+    [[nodiscard]] const T &end() const
+    {
+        return end_;
+    }
+
+    // The items after the gap keep their distance from the end
+    void setEnd(const T &end)
+    {
+        end_ = end;
+    }
+
+    [[nodiscard]] std::vector<T> &before()
+    {
+        return before_;
+    }
+
+    [[nodiscard]] const std::vector<T> &before() const
+    {
+        return before_;
+    }
+
+    // In reverse, counted back from the end
+    [[nodiscard]] std::vector<T> &after()
+    {
+        return after_;
+    }
+
+    [[nodiscard]] const std::vector<T> &after() const
+    {
+        return after_;
+    }
+
+private:
+    std::vector<T> before_;
+    std::vector<T> after_;
+    T end_{};
+}; /* End of class SplitIndex */
+
+} /* End of namespace cmdly */
+
+#endif /* !CMDLY_SPLIT_INDEX_H */
@@ -6,24 +6,75 @@
 #define CMDLY_STYLE_H
 
 #include <cstdint>
-#include <sstream>
-#include <iomanip>
-#include <cmdly/string.h>
+#include <ostream>
+#include <string>
+#include <string_view>
 
 namespace cmdly {
 
+// Text of a known maximum length kept inline, so it can be built at compile time and copied
+// without allocating
+template<std::size_t N>
+class FixedString
+{
+public:
+    constexpr FixedString() = default;
+
+    constexpr FixedString &append(std::string_view s)
+    {
+        for (char c : s)
+        {
+            data_[size_++] = c;
+        }
+        return *this;
+    }
+
+    constexpr FixedString &appendNumber(std::uint32_t value)
+    {
+        char digits[10] = {};
+        std::size_t count = 0;
+        do
+        {
+            digits[count++] = char('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        while (count > 0)
+        {
+            data_[size_++] = digits[--count];
+        }
+        return *this;
+    }
+
+    constexpr FixedString &appendHex(std::uint8_t value)
+    {
+        constexpr std::string_view HEX = "0123456789abcdef";
+        data_[size_++] = HEX[value >> 4];
+        data_[size_++] = HEX[value & 0x0F];
+        return *this;
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const
+    {
+        return {data_, size_};
+    }
+
+private:
+    char data_[N] = {};
+    std::size_t size_{0};
+}; /* End of class FixedString */
+
 // RGB-color
 struct RgbColor
 {
-    static RgbColor Default;
-    static RgbColor Black;
-    static RgbColor Red;
-    static RgbColor Green;
-    static RgbColor Yellow;
-    static RgbColor Blue;
-    static RgbColor Magenta;
-    static RgbColor Cyan;
-    static RgbColor White;
+    static const RgbColor Default;
+    static const RgbColor Black;
+    static const RgbColor Red;
+    static const RgbColor Green;
+    static const RgbColor Yellow;
+    static const RgbColor Blue;
+    static const RgbColor Magenta;
+    static const RgbColor Cyan;
+    static const RgbColor White;
 
     static constexpr std::string_view TERMINATOR = "\033[0m";
 
@@ -32,62 +83,82 @@ struct RgbColor
     std::uint8_t blue;
     bool is_default;
 
-    explicit RgbColor() :
+    constexpr explicit RgbColor() :
         red(0), green(0), blue(0), is_default(true)
     {}
 
-    explicit RgbColor(std::uint8_t red_, std::uint8_t green_, std::uint8_t blue_) :
+    constexpr explicit RgbColor(std::uint8_t red_, std::uint8_t green_, std::uint8_t blue_) :
         red(red_), green(green_), blue(blue_), is_default(false)
     {}
 
-    bool operator==(const RgbColor &color) const
+    constexpr bool operator==(const RgbColor &color) const
     {
         return red == color.red && green == color.green && blue == color.blue && is_default == color.is_default;
     }
 
-    bool operator!=(const RgbColor &color) const
+    constexpr bool operator!=(const RgbColor &color) const
     {
         return !(*this == color);
     }
 }; /* End of struct RgbColor */
 
+inline constexpr RgbColor RgbColor::Default = RgbColor();
+inline constexpr RgbColor RgbColor::Black = RgbColor(0, 0, 0);
+inline constexpr RgbColor RgbColor::Red = RgbColor(205, 0, 0);
+inline constexpr RgbColor RgbColor::Green = RgbColor(0, 205, 0);
+inline constexpr RgbColor RgbColor::Yellow = RgbColor(205, 205, 0);
+inline constexpr RgbColor RgbColor::Blue = RgbColor(0,111,184);
+inline constexpr RgbColor RgbColor::Magenta = RgbColor(205, 0, 205);
+inline constexpr RgbColor RgbColor::Cyan = RgbColor(0, 205, 205);
+inline constexpr RgbColor RgbColor::White = RgbColor(229, 229, 229);
+
 // 256-color mode
 struct Color
 {
-    static Color Default;
-    static Color Black;
-    static Color Red;
-    static Color Green;
-    static Color Yellow;
-    static Color Blue;
-    static Color Magenta;
-    static Color Cyan;
-    static Color White;
+    static const Color Default;
+    static const Color Black;
+    static const Color Red;
+    static const Color Green;
+    static const Color Yellow;
+    static const Color Blue;
+    static const Color Magenta;
+    static const Color Cyan;
+    static const Color White;
 
     static constexpr std::string_view TERMINATOR = "\033[0m";
 
     std::uint8_t code;
     bool is_default;
 
-    explicit Color() :
+    constexpr explicit Color() :
         code(0), is_default(true)
     {}
 
-    explicit Color(std::uint8_t code_) :
+    constexpr explicit Color(std::uint8_t code_) :
         code(code_), is_default(false)
     {}
 
-    bool operator==(const Color &color) const
+    constexpr bool operator==(const Color &color) const
     {
         return code == color.code && is_default == color.is_default;
     }
 
-    bool operator!=(const Color &color) const
+    constexpr bool operator!=(const Color &color) const
     {
         return !(*this == color);
     }
 }; /* End of struct Color */
 
+inline constexpr Color Color::Default = Color();
+inline constexpr Color Color::Black = Color(0);
+inline constexpr Color Color::Red = Color(1);
+inline constexpr Color Color::Green = Color(2);
+inline constexpr Color Color::Yellow = Color(3);
+inline constexpr Color Color::Blue = Color(4);
+inline constexpr Color Color::Magenta = Color(5);
+inline constexpr Color Color::Cyan = Color(6);
+inline constexpr Color Color::White = Color(7);
+
 enum class FontStyle : std::uint16_t
 {
     Default = 0,
@@ -104,108 +175,137 @@ enum class FontStyle : std::uint16_t
 
 constexpr std::uint8_t FONT_STYLE_NUM = 10;
 
-inline std::uint16_t operator&(const FontStyle &s1, const FontStyle &s2)
+constexpr std::uint16_t operator&(const FontStyle &s1, const FontStyle &s2)
 {
     return static_cast<std::uint16_t>(s1) & static_cast<std::uint16_t>(s2);
 }
 
-inline FontStyle operator|(const FontStyle &s1, const FontStyle &s2)
+constexpr FontStyle operator|(const FontStyle &s1, const FontStyle &s2)
 {
     return static_cast<FontStyle>(static_cast<std::uint16_t>(s1) | static_cast<std::uint16_t>(s2));
 }
 
+// Longest sequences: both colors ("\033[38;5;255m") and every font style ("\033[9m")
+constexpr std::size_t TEXT_SEQUENCE_MAX = 2 * 11 + (FONT_STYLE_NUM - 1) * 4;
+// "\033]12;#rrggbb\033\\"
+constexpr std::size_t CURSOR_SEQUENCE_MAX = 14;
+
 class ColorConverter
 {
 public:
-    static std::string fontStyleToCodeSequence(const FontStyle &font_style)
+    using TextSequence = FixedString<TEXT_SEQUENCE_MAX>;
+    using CursorSequence = FixedString<CURSOR_SEQUENCE_MAX>;
+
+    static constexpr void appendFontStyle(TextSequence &sequence, const FontStyle &font_style)
     {
-        std::ostringstream oss;
-        for (int i = 1; i < FONT_STYLE_NUM; ++i)
+        for (std::uint32_t i = 1; i < FONT_STYLE_NUM; ++i)
         {
             if (static_cast<std::uint16_t>(font_style) & (1 << i))
             {
-                oss << "\033[" << i << "m";
+                sequence.append("\033[").appendNumber(i).append("m");
             }
         }
-        return oss.str();
     }
 
-    static std::string cursorRgbColorToCodeSequence(const RgbColor &color)
+    static constexpr void appendForegroundColor(TextSequence &sequence, const Color &color)
+    {
+        appendColor(sequence, color, 38);
+    }
+
+    static constexpr void appendBackgroundColor(TextSequence &sequence, const Color &color)
     {
+        appendColor(sequence, color, 48);
+    }
+
+    static constexpr CursorSequence cursorColor(const RgbColor &color)
+    {
+        CursorSequence sequence;
         if (color.is_default)
         {
-            return "\033]112\007";
+            sequence.append("\033]112\007");
+            return sequence;
         }
-        std::ostringstream oss;
-        oss << "\033]12;#";
-        oss << std::hex << std::setfill('0') << std::setw(2) << int(color.red);
-        oss << std::hex << std::setfill('0') << std::setw(2) << int(color.green);
-        oss << std::hex << std::setfill('0') << std::setw(2) << int(color.blue);
-        oss << "\033\\";
-        return oss.str();
+        sequence.append("\033]12;#").appendHex(color.red).appendHex(color.green).appendHex(color.blue);
+        sequence.append("\033\\");
+        return sequence;
     }
 
-    static std::string foregroundTextColorToCodeSequence(const Color &color)
+    static std::string fontStyleToCodeSequence(const FontStyle &font_style)
     {
-        return colorToCodeSequence(color, 38);
+        TextSequence sequence;
+        appendFontStyle(sequence, font_style);
+        return std::string(sequence.view());
     }
 
-    static std::string backgroundTextColorToCodeSequence(const Color &color)
+    static std::string cursorRgbColorToCodeSequence(const RgbColor &color)
     {
-        return colorToCodeSequence(color, 48);
+        return std::string(cursorColor(color).view());
     }
 
-private:
-    static std::string colorToCodeSequence(const Color &color, std::uint32_t code)
+    static std::string foregroundTextColorToCodeSequence(const Color &color)
     {
-        if (color.is_default)
-        {
-            return "";
-        }
-        return string::format("\033[{};5;{}m", code, int(color.code));
+        TextSequence sequence;
+        appendForegroundColor(sequence, color);
+        return std::string(sequence.view());
     }
 
-    static std::string rgbColorToCodeSequence(const RgbColor &color, std::uint32_t code)
+    static std::string backgroundTextColorToCodeSequence(const Color &color)
     {
-        if (color.is_default)
+        TextSequence sequence;
+        appendBackgroundColor(sequence, color);
+        return std::string(sequence.view());
+    }
+
+private:
+    static constexpr void appendColor(TextSequence &sequence, const Color &color, std::uint32_t code)
+    {
+        if (!color.is_default)
         {
-            return "";
+            sequence.append("\033[").appendNumber(code).append(";5;").appendNumber(color.code).append("m");
         }
-        return string::format("\033[{};2;{};{};{}m", code, int(color.red), int(color.green), int(color.blue));
     }
 };
 
+// The escape sequence is built when the style is constructed, at compile time for a constexpr style,
+// and kept inline: copying a style or writing it out never allocates
 class TextStyle
 {
 public:
-    static TextStyle Default;
+    static const TextStyle Default;
 
-    explicit TextStyle(Color foreground_color = Color::Default,
-                       Color background_color = Color::Default,
-                       FontStyle font_style = FontStyle::Default) :
+    constexpr explicit TextStyle(Color foreground_color = Color::Default,
+                                 Color background_color = Color::Default,
+                                 FontStyle font_style = FontStyle::Default) :
         foreground_color_(foreground_color), background_color_(background_color), font_style_(font_style)
     {
-        code_sequence_ = convertToCodeSequence();
+        ColorConverter::appendForegroundColor(code_sequence_, foreground_color_);
+        ColorConverter::appendBackgroundColor(code_sequence_, background_color_);
+        ColorConverter::appendFontStyle(code_sequence_, font_style_);
+    }
+
+    [[nodiscard]] constexpr std::string_view view() const
+    {
+        return code_sequence_.view();
     }
 
     [[nodiscard]] std::string str() const
     {
-        return code_sequence_;
+        return std::string(view());
     }
 
-    bool operator==(const TextStyle &text_style) const
+    constexpr bool operator==(const TextStyle &text_style) const
     {
-        return code_sequence_ == text_style.code_sequence_;
+        return view() == text_style.view();
     }
 
-    bool operator!=(const TextStyle &text_style) const
+    constexpr bool operator!=(const TextStyle &text_style) const
     {
         return !(*this == text_style);
     }
 
     friend std::ostream &operator<<(std::ostream &stream, const TextStyle &text_style)
     {
-        stream << text_style.code_sequence_;
+        stream << text_style.view();
         return stream;
     }
 
@@ -213,57 +313,43 @@ private:
     Color foreground_color_;
     Color background_color_;
     FontStyle font_style_;
-    std::string code_sequence_;
-
-    std::string convertToCodeSequence()
-    {
-        if (foreground_color_ == Color::Default && background_color_ == Color::Default
-            && font_style_ == FontStyle::Default)
-        {
-            return "";
-        }
-        std::ostringstream oss;
-        oss << ColorConverter::foregroundTextColorToCodeSequence(foreground_color_);
-        oss << ColorConverter::backgroundTextColorToCodeSequence(background_color_);
-        oss << ColorConverter::fontStyleToCodeSequence(font_style_);
-        return oss.str();
-    }
+    ColorConverter::TextSequence code_sequence_;
 }; /* End of class TextStyle */
 
+inline constexpr TextStyle TextStyle::Default = TextStyle();
+
 class CursorStyle
 {
 public:
-    static CursorStyle Default;
+    static const CursorStyle Default;
+
+    constexpr explicit CursorStyle(const RgbColor &color = RgbColor::Default) :
+        color_(color), code_sequence_(ColorConverter::cursorColor(color))
+    {}
 
-    explicit CursorStyle(const RgbColor &color = RgbColor::Default) :
-        color_(color)
+    [[nodiscard]] constexpr std::string_view view() const
     {
-        if (color_ == RgbColor::Default)
-        {
-            code_sequence_ = "\033]112\007";
-        }
-        else
-        {
-            code_sequence_ = ColorConverter::cursorRgbColorToCodeSequence(color);
-        }
+        return code_sequence_.view();
     }
 
     [[nodiscard]] std::string str() const
     {
-        return code_sequence_;
+        return std::string(view());
     }
 
     friend std::ostream &operator<<(std::ostream &stream, const CursorStyle &cursor_style)
     {
-        stream << cursor_style.code_sequence_;
+        stream << cursor_style.view();
         return stream;
     }
 
 private:
     RgbColor color_;
-    std::string code_sequence_;
+    ColorConverter::CursorSequence code_sequence_;
 }; /* End of class CursorStyle */
 
+inline constexpr CursorStyle CursorStyle::Default = CursorStyle();
+
 } /* End of namespace cmdly */
 
 #endif /* !CMDLY_STYLE_H */
@@ -7,16 +7,25 @@
 
 #include <iostream>
 
+#include <chrono>
 #include <map>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <string_view>
 #include <cmdly/style.h>
 #include <cmdly/line.h>
+#include <cmdly/highlight.h>
 #include <cmdly/cursor.h>
 #include <cmdly/listener.h>
 #include <cmdly/history.h>
+#include <cmdly/command.h>
 #include <cmdly/completion.h>
 #include <cmdly/io.h>
+#include <cmdly/decoder.h>
+#include <cmdly/reactor.h>
+#include <cmdly/coroutine.h>
+#include <cmdly/queue.h>
 
 namespace cmdly {
 
@@ -24,13 +33,72 @@ class Terminal
 {
 public:
     struct Size { std::size_t cols, rows; };
+
+    class LineAwaiter
+    {
+    public:
+        LineAwaiter(Terminal &terminal, std::string prompt) :
+            terminal_(terminal), prompt_(std::move(prompt))
+        {}
+
+        [[nodiscard]] bool await_ready() const
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        std::string await_resume()
+        {
+            return std::move(line_);
+        }
+
+    private:
+        friend class Terminal;
+        Terminal &terminal_;
+        std::string prompt_;
+        std::string line_;
+        std::coroutine_handle<> handle_;
+    }; /* End of class LineAwaiter */
+
+    class KeyAwaiter
+    {
+    public:
+        explicit KeyAwaiter(Terminal &terminal) :
+            terminal_(terminal), key_(Key::Any)
+        {}
+
+        [[nodiscard]] bool await_ready() const
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle);
+
+        Key await_resume()
+        {
+            return std::move(key_);
+        }
+
+    private:
+        friend class Terminal;
+        Terminal &terminal_;
+        Key key_;
+        std::coroutine_handle<> handle_;
+    }; /* End of class KeyAwaiter */
+
     explicit Terminal(const std::shared_ptr<IO> &io = std::make_shared<StandardIO>(),
                       const std::shared_ptr<History> &history = std::make_shared<MemoryHistory>(),
                       const std::shared_ptr<Completion> &completion = std::make_shared<Completion>());
 
+    virtual ~Terminal();
+
     const std::shared_ptr<IO> &io();
     const std::shared_ptr<History> &history();
     const std::shared_ptr<Completion> &completion();
+    // Commands run by their handlers when entered and completed word by word, "exit", "quit" and
+    // "history" are there already
+    const std::shared_ptr<CommandTree> &commands();
 
     void onKeyPressed(const Key &key, const KeyPressedListener::FunctionType &handler);
     void addKeyPressedListener(const Key &key, const std::shared_ptr<KeyPressedListener> &listener);
@@ -51,10 +119,36 @@ public:
     void setCursorStyle(const CursorStyle &style);
     const CursorStyle& getCursorStyle();
     void resetStyle();
-
+    // Lines wider than the terminal scroll horizontally (on by default) instead of wrapping
+    void setHorizontalScroll(bool enabled);
+    // Lines are drawn in the styles of the tokens the highlighter splits them into
+    void setHighlighter(const std::shared_ptr<Highlighter> &highlighter);
+    // The rest of the most recent history line starting with what was typed is shown dimmed after
+    // the cursor (on by default), ArrowRight at the end of the line accepts it
+    void setAutosuggest(bool enabled);
+
+    // Edits lines interactively, or reads them in batch when the IO is not a terminal
     void run(const std::string &prompt);
     std::string readLine(const std::string &prompt);
     void writeText(const std::string &text, const TextStyle &text_style = TextStyle::Default);
+    // Safe to call from any thread: the text is written between key events, above the line being edited
+    void postText(const std::string &text, const TextStyle &text_style = TextStyle::Default);
+
+    // Non-blocking mode: input is fed by the application or by the reactor, entered lines go to listeners
+    void start(const std::string &prompt);
+    void stop();
+    [[nodiscard]] bool isRunning() const;
+    // Called once the terminal has stopped, e.g. at the end of input or after "exit"
+    void onStop(const std::function<void(Terminal &)> &handler);
+    void feed(std::string_view data);
+    bool pollOnce(std::chrono::milliseconds timeout = std::chrono::milliseconds(-1));
+    const std::shared_ptr<Reactor> &reactor();
+    void setReactor(const std::shared_ptr<Reactor> &reactor);
+    void setEscTimeout(std::chrono::milliseconds timeout);
+
+    // Coroutine interface, awaiting requires an Executor running on the same thread
+    LineAwaiter readLineAsync(const std::string &prompt);
+    KeyAwaiter nextKeyAsync();
 
     void bell();
     void clearCurrentLine();
@@ -64,6 +158,7 @@ protected:
     std::shared_ptr<IO> io_;
     std::shared_ptr<History> history_;
     std::shared_ptr<Completion> completion_;
+    std::shared_ptr<CommandTree> commands_;
     std::map<Key, std::vector<std::shared_ptr<KeyPressedListener>>> key_pressed_listeners_;
     std::vector<std::shared_ptr<LineChangedListener>> line_changed_listeners_;
     std::vector<std::shared_ptr<LineEnteredListener>> line_entered_listeners_;
@@ -71,9 +166,62 @@ protected:
     TextStyle line_style_;
     CursorStyle cursor_style_;
 
+    // State of the line being edited
+    std::unique_ptr<Line> line_;
+    std::unique_ptr<Cursor> cursor_;
+    std::string content_;
+    std::uint64_t revision_{0};
+    bool horizontal_scroll_{true};
+    std::shared_ptr<Highlighter> highlighter_;
+    bool autosuggest_{true};
+    // Leading bytes of a UTF-8 character typed but not complete yet
+    std::string utf8_pending_;
+
+    // State of the non-blocking mode
+    std::shared_ptr<Reactor> reactor_;
+    std::unique_ptr<RawMode> raw_mode_;
+    KeyDecoder decoder_;
+    std::string prompt_;
+    bool running_{false};
+    bool processing_{false};
+    bool stop_requested_{false};
+    bool auto_prompt_{false};
+    std::function<void(Terminal &)> stop_handler_;
+    LineAwaiter *line_waiter_{nullptr};
+    KeyAwaiter *key_waiter_{nullptr};
+    std::chrono::milliseconds esc_timeout_{100};
+    std::chrono::steady_clock::time_point esc_deadline_;
+    // timer of the reactor delivering a lonely <ESC> when the deadline passes, -1 when not armed
+    int esc_timer_{-1};
+
+    // Text posted by other threads, drained by the thread running the terminal
+    MpscQueue<std::string> posted_;
+    std::atomic<bool> wake_pending_{false};
+
+    // Set while lines are read in batch, styles and control sequences are not written then
+    bool batch_{false};
+
     void registerDefaultKeyListeners();
     void registerDefaultLineEnteredListeners();
 
+    void runBatch();
+    bool processBatchLine(std::string content);
+
+    void startInput();
+    void stopInput();
+    void resumeWaiters();
+    static Executor &currentExecutor();
+    void beginLine(const std::string &prompt);
+    bool processKey(const Key &key);
+    void drainPostedText();
+    bool editLine(const Key &key);
+    void suggest();
+    void processFedInput(bool flush_pending);
+    void cancelEscTimer();
+    void processFedKey(const Key &key);
+    std::string endLine();
+    void abortLine();
+
     KeyPressedListener::Status handleKeyPressed(const Key &key, Line &line, Cursor &cursor);
     LineChangedListener::Status handleLineChanged(const std::string &content, Line &line, Cursor &cursor);
     LineEnteredListener::Status handleLineEntered(const std::string &content);
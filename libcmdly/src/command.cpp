@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <algorithm>
+#include <charconv>
+#include <stdexcept>
+#include <cmdly/command.h>
+#include <cmdly/string.h>
+#include <cmdly/terminal.h>
+
+using namespace cmdly;
+
+bool CommandTree::Argument::accepts(std::string_view value) const
+{
+    switch (type)
+    {
+    case Type::Integer:
+    {
+        std::int64_t number;
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+        return error == std::errc() && end == value.data() + value.size();
+    }
+    case Type::Choice:
+        return std::find(choices.begin(), choices.end(), value) != choices.end();
+    default:
+        return true;
+    }
+}
+
+std::vector<std::string> CommandTree::Argument::complete(std::string_view prefix) const
+{
+    if (completer)
+    {
+        return completer(prefix);
+    }
+    std::vector<std::string> values;
+    for (auto &value : choices)
+    {
+        if (value.starts_with(prefix))
+        {
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+bool CommandTree::Invocation::has(std::string_view name) const
+{
+    return std::any_of(arguments_.begin(), arguments_.end(), [name](const auto &argument) {
+        return argument.first == name;
+    });
+}
+
+const std::string &CommandTree::Invocation::get(std::string_view name) const
+{
+    for (auto &argument : arguments_)
+    {
+        if (argument.first == name)
+        {
+            return argument.second;
+        }
+    }
+    throw std::out_of_range("no argument " + std::string(name));
+}
+
+std::int64_t CommandTree::Invocation::integer(std::string_view name) const
+{
+    auto &value = get(name);
+    std::int64_t number = 0;
+    std::from_chars(value.data(), value.data() + value.size(), number);
+    return number;
+}
+
+CommandTree::Command &CommandTree::Command::command(const std::string &name)
+{
+    auto &command = commands_[name];
+    if (!command)
+    {
+        command = std::make_unique<Command>(path_.empty() ? name : path_ + " " + name);
+    }
+    return *command;
+}
+
+CommandTree::Command &CommandTree::Command::argument(const std::string &name, Argument::Type type, bool optional)
+{
+    arguments_.push_back({name, type, optional, {}, {}});
+    return *this;
+}
+
+CommandTree::Command &CommandTree::Command::choice(const std::string &name, std::vector<std::string> choices, bool optional)
+{
+    arguments_.push_back({name, Argument::Type::Choice, optional, std::move(choices), {}});
+    return *this;
+}
+
+CommandTree::Command &CommandTree::Command::complete(Completer completer)
+{
+    if (!arguments_.empty())
+    {
+        arguments_.back().completer = std::move(completer);
+    }
+    return *this;
+}
+
+CommandTree::Command &CommandTree::Command::handle(Handler handler)
+{
+    handler_ = std::move(handler);
+    return *this;
+}
+
+CommandTree::Command &CommandTree::Command::hide()
+{
+    hidden_ = true;
+    return *this;
+}
+
+const CommandTree::Command *CommandTree::Command::find(const std::string &name) const
+{
+    auto it = commands_.find(name);
+    return it == commands_.end() ? nullptr : it->second.get();
+}
+
+std::string CommandTree::Command::usage() const
+{
+    std::string usage = "usage: " + path_;
+    if (!commands_.empty())
+    {
+        std::vector<std::string> names;
+        for (auto &command : commands_)
+        {
+            names.push_back(command.first);
+        }
+        std::sort(names.begin(), names.end());
+        // without a handler of its own one of the subcommands has to follow
+        usage += handler_ ? " [" : " {";
+        for (std::size_t i = 0; i < names.size(); ++i)
+        {
+            usage += (i > 0 ? "|" : "") + names[i];
+        }
+        usage += handler_ ? "]" : "}";
+    }
+    for (auto &argument : arguments_)
+    {
+        usage += argument.optional ? " [<" + argument.name + ">]" : " <" + argument.name + ">";
+    }
+    return usage;
+}
+
+std::vector<std::string> CommandTree::names() const
+{
+    std::vector<std::string> names;
+    for (auto &command : root_.commands_)
+    {
+        names.push_back(command.first);
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+CommandTree::Status CommandTree::invoke(const std::string &content, Terminal &terminal)
+{
+    auto tokens = tokenize(content);
+    const Command *command = &root_;
+    std::size_t i = 0;
+    for (; i < tokens.size(); ++i)
+    {
+        auto *subcommand = command->find(tokens[i].text);
+        if (!subcommand)
+        {
+            break;
+        }
+        command = subcommand;
+    }
+    // words after a command taking none make the line something else, e.g. "history clear" with
+    // "history" built in
+    if (command == &root_ || (i < tokens.size() && command->arguments_.empty()))
+    {
+        return Status::OK;
+    }
+
+    // the words after the command are its arguments
+    Invocation invocation;
+    for (std::size_t j = 0; j < i; ++j)
+    {
+        invocation.path_.push_back(tokens[j].text);
+    }
+    auto &arguments = command->arguments_;
+    bool valid = command->handler_ && tokens.size() - i <= arguments.size();
+    for (std::size_t a = 0; valid && a < arguments.size(); ++a)
+    {
+        if (i + a == tokens.size())
+        {
+            valid = arguments[a].optional;
+            break;
+        }
+        auto &value = tokens[i + a].text;
+        if (!arguments[a].accepts(value))
+        {
+            terminal.writeText(string::format("{}: invalid <{}>: {}\n", command->path(), arguments[a].name, value));
+            valid = false;
+            break;
+        }
+        invocation.arguments_.emplace_back(arguments[a].name, value);
+    }
+    if (!valid)
+    {
+        terminal.writeText(command->usage() + "\n");
+        return Status::CONTINUE;
+    }
+    return command->handler_(invocation, terminal);
+}
+
+bool CommandTree::complete(const std::vector<std::string> &words, std::string_view prefix,
+                           std::vector<std::string> &candidates) const
+{
+    const Command *command = &root_;
+    std::size_t argument = 0;
+    for (auto &word : words)
+    {
+        auto *subcommand = argument == 0 ? command->find(word) : nullptr;
+        if (subcommand)
+        {
+            command = subcommand;
+            continue;
+        }
+        if (command == &root_ || argument >= command->arguments_.size())
+        {
+            return false;
+        }
+        argument++;
+    }
+
+    candidates.clear();
+    if (argument == 0)
+    {
+        for (auto &subcommand : command->commands_)
+        {
+            if (!subcommand.second->hidden_ && subcommand.first.starts_with(prefix))
+            {
+                candidates.push_back(subcommand.first);
+            }
+        }
+    }
+    if (argument < command->arguments_.size())
+    {
+        for (auto &value : command->arguments_[argument].complete(prefix))
+        {
+            if (value.starts_with(prefix))
+            {
+                candidates.push_back(std::move(value));
+            }
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    return true;
+}
+
+std::vector<CommandTree::Token> CommandTree::tokenize(std::string_view text)
+{
+    std::vector<Token> tokens;
+    for (std::size_t i = 0; i < text.size();)
+    {
+        if (text[i] == ' ' || text[i] == '\t')
+        {
+            i++;
+            continue;
+        }
+        Token token{"", i, i};
+        bool quoted = false;
+        for (; i < text.size() && (quoted || (text[i] != ' ' && text[i] != '\t')); ++i)
+        {
+            if (text[i] == '"')
+            {
+                quoted = !quoted;
+                continue;
+            }
+            token.text += text[i];
+        }
+        token.end = i;
+        tokens.push_back(std::move(token));
+    }
+    return tokens;
+}
@@ -11,16 +11,27 @@
 using namespace cmdly;
 
 Completion::Completion() :
-    key_tab_counter_(0), longest_word_length_(0)
+    key_tab_counter_(0), longest_word_length_(0),
+    matching_(Matching::Prefix), fuzzy_limit_(FUZZY_LIMIT), fuzzy_threads_(0),
+    menu_begin_(0), menu_end_(0),
+    selected_style_(menu_.addStyle(TextStyle(Color::Default, Color::Default, FontStyle::Invert))),
+    selected_(std::string::npos), menu_columns_(1), column_width_(0), first_row_(0)
 {}
 
 void Completion::insert(const std::string& word)
 {
-    words_.insert(word);
+    if (!words_.insert(word))
+    {
+        return;
+    }
     if (word.size() > longest_word_length_)
     {
         longest_word_length_ = word.size();
     }
+    if (matching_ == Matching::Fuzzy)
+    {
+        fuzzy_.insert(word);
+    }
 }
 
 void Completion::insert(std::initializer_list<std::string> words)
@@ -33,66 +44,124 @@ void Completion::insert(std::initializer_list<std::string> words)
 
 std::shared_ptr<Completion::SearchResult> Completion::search(const std::string& phrase)
 {
-    // if nothing to search, then return all words we have
-    if (phrase.empty())
+    if (matching_ == Matching::Fuzzy && !phrase.empty())
     {
-        auto words = std::vector<std::string>(words_.begin(), words_.end());
-        return std::make_shared<Completion::SearchResult>(words, longest_word_length_, "");
+        return searchFuzzy(phrase);
     }
 
-    // make a search
     auto result = std::make_shared<SearchResult>();
+    std::string prefix;
+    auto node = words_.find(phrase, prefix);
+    if (node == CompletionIndex::NONE)
+    {
+        return result;
+    }
+
+    // words come out of the index in order, the ones of the phrase only
     result->smallest_word_length = longest_word_length_;
-    for (auto& word: words_)
+    words_.visit(node, prefix, [&result](const std::string &word) {
+        result->longest_word_length = std::max(result->longest_word_length, word.size());
+        result->smallest_word_length = std::min(result->smallest_word_length, word.size());
+        result->words.push_back(word);
+    });
+
+    // the path to the node is the common prefix, given for at least 2 words of a phrase
+    if (!phrase.empty() && result->size() > 1)
     {
-        if (word.starts_with(phrase))
-        {
-            if (word.size() > result->longest_word_length)
-            {
-                result->longest_word_length = word.size();
-            }
-            if (word.size() < result->smallest_word_length)
-            {
-                result->smallest_word_length = word.size();
-            }
-            result->words.push_back(word);
-        }
+        result->longest_common_prefix = prefix;
     }
 
-    // if found 0 or 1 word, return result immediately
-    if (result->size() < 2)
+    return result;
+}
+
+// Ranked matches have nothing in common to complete, the menu offers them best first
+std::shared_ptr<Completion::SearchResult> Completion::searchFuzzy(const std::string& phrase)
+{
+    auto result = std::make_shared<SearchResult>();
+    auto matches = fuzzy_.search(phrase, fuzzy_limit_, fuzzy_threads_);
+    if (matches.empty())
     {
         return result;
     }
+    result->smallest_word_length = longest_word_length_;
+    for (auto &match : matches)
+    {
+        auto &word = fuzzy_.word(match.index);
+        result->longest_word_length = std::max(result->longest_word_length, word.size());
+        result->smallest_word_length = std::min(result->smallest_word_length, word.size());
+        result->words.push_back(word);
+    }
+    return result;
+}
+
+// The words are copied for fuzzy matching when it is turned on, prefix matching needs the index only
+void Completion::setMatching(Matching matching)
+{
+    matching_ = matching;
+    fuzzy_.clear();
+    if (matching_ == Matching::Fuzzy)
+    {
+        std::string prefix;
+        words_.visit(words_.find("", prefix), prefix, [this](const std::string &word) {
+            fuzzy_.insert(word);
+        });
+    }
+}
 
-    // find longest common prefix
-    std::string first = result->words.front();
-    std::string last = result->words.back();
-    std::size_t i = 0;
-    for (i = 0; i < result->smallest_word_length && first[i] == last[i]; ++i)
-    {}
-    result->longest_common_prefix = first.substr(0, i);
+Completion::Matching Completion::matching() const
+{
+    return matching_;
+}
 
-    return result;
+void Completion::setFuzzyLimit(std::size_t limit)
+{
+    fuzzy_limit_ = std::max<std::size_t>(limit, 1);
+}
+
+void Completion::setFuzzyThreads(std::size_t threads)
+{
+    fuzzy_threads_ = threads;
 }
 
 Completion::Status Completion::invoke(const Key &key, Line &line, Cursor &cursor, Terminal &terminal)
 {
+    if (key == Key::Resize)
+    {
+        // the terminal moved things around, the menu is laid out again below the line
+        if (isMenuOpen())
+        {
+            openMenu(line, terminal);
+        }
+        return Status::OK;
+    }
+
+    if (isMenuOpen())
+    {
+        return navigateMenu(key, line, cursor, terminal);
+    }
+
     if (key != Key::Tab)
     {
         key_tab_counter_ = 0;
         return Status::OK;
     }
 
-    auto phrase = line.content();
+    std::string content(line.content());
     key_tab_counter_++;
-    if (key_tab_counter_ == 1 && phrase.empty())
+    if (key_tab_counter_ == 1 && content.empty())
     {
         terminal.bell();
         return Status::OK;
     }
 
-    auto result = search(phrase);
+    // the word under the cursor when the commands know what comes there, the whole line otherwise
+    std::size_t begin = 0;
+    std::size_t end = content.size();
+    auto result = searchCommands(content, cursor.index() - line.prompt().length(), begin, end);
+    if (!result)
+    {
+        result = search(content);
+    }
     if (result->empty())
     {
         return Status::OK;
@@ -100,56 +169,252 @@ Completion::Status Completion::invoke(const Key &key, Line &line, Cursor &cursor
 
     if (result->size() == 1)
     {
-        const std::string first_word = result->words.front();
-        line.setContent(first_word);
+        end = replace(line, begin, end, result->words.front() + " ");
     }
     else if (!result->longest_common_prefix.empty())
     {
-        line.setContent(result->longest_common_prefix);
+        end = replace(line, begin, end, result->longest_common_prefix);
     }
 
-    if (result->size() == 1)
+    key_tab_counter_ = 0;
+    line.update();
+    cursor.moveTo(line.prompt().length() + end);
+
+    if (result->size() > 1)
     {
-        line.append(" ");
+        menu_result_ = result;
+        menu_begin_ = begin;
+        menu_end_ = end;
+        selected_ = std::string::npos;
+        first_row_ = 0;
+        openMenu(line, terminal);
     }
-    else
+
+    return Status::OK;
+}
+
+void Completion::setCommands(const std::shared_ptr<CommandTree> &commands)
+{
+    commands_ = commands;
+}
+
+// Words after a command are completed from the command tree. The first word is completed from the
+// completion words and the names of the commands when the application declared some starting with
+// it, from the words alone as the whole line otherwise.
+std::shared_ptr<Completion::SearchResult> Completion::searchCommands(const std::string &content, std::size_t at,
+                                                                     std::size_t &begin, std::size_t &end)
+{
+    if (!commands_)
     {
-        showSearchResult(terminal, result);
+        return nullptr;
     }
 
-    key_tab_counter_ = 0;
-    line.update();
-    cursor.moveToEnd();
+    auto tokens = CommandTree::tokenize(std::string_view(content).substr(0, at));
+    std::string prefix;
+    auto word_begin = at;
+    if (!tokens.empty() && tokens.back().end == at)
+    {
+        prefix = tokens.back().text;
+        word_begin = tokens.back().begin;
+        tokens.pop_back();
+    }
+    std::vector<std::string> words;
+    for (auto &token : tokens)
+    {
+        words.push_back(token.text);
+    }
+    auto result = std::make_shared<SearchResult>();
+    if (!commands_->complete(words, prefix, result->words) || (words.empty() && result->empty()))
+    {
+        return nullptr;
+    }
+    if (words.empty())
+    {
+        // the names come sorted from the tree, the words join them unless they are one of them
+        auto names = std::ptrdiff_t(result->words.size());
+        auto found = search(prefix);
+        for (auto &word : found->words)
+        {
+            if (!std::binary_search(result->words.begin(), result->words.begin() + names, word))
+            {
+                result->words.push_back(std::move(word));
+            }
+        }
+        if (matching_ == Matching::Prefix)
+        {
+            std::sort(result->words.begin(), result->words.end());
+        }
+    }
 
-    return Status::OK;
+    begin = word_begin;
+    end = at;
+    if (result->empty())
+    {
+        return result;
+    }
+    result->smallest_word_length = SIZE_MAX;
+    for (auto &word : result->words)
+    {
+        result->longest_word_length = std::max(result->longest_word_length, word.size());
+        result->smallest_word_length = std::min(result->smallest_word_length, word.size());
+    }
+    if (result->size() > 1 && (!words.empty() || matching_ == Matching::Prefix))
+    {
+        // the candidates are in order, what the first and the last share all of them do
+        auto &first = result->words.front();
+        auto &last = result->words.back();
+        auto length = std::size_t(std::mismatch(first.begin(), first.begin() + std::ptrdiff_t(result->smallest_word_length),
+                                                last.begin()).first - first.begin());
+        result->longest_common_prefix = first.substr(0, length);
+    }
+    return result;
 }
 
-void Completion::showSearchResult(Terminal &terminal, std::shared_ptr<Completion::SearchResult>& result)
+// Puts text in place of the content in [begin, end), returns where the text ends
+std::size_t Completion::replace(Line &line, std::size_t begin, std::size_t end, const std::string &text)
 {
-    if (result->empty())
+    auto content = line.content();
+    if (begin == 0 && end == content.size())
+    {
+        line.setContent(text);
+    }
+    else
+    {
+        auto offset = line.prompt().length();
+        line.erase(offset + begin, end - begin);
+        line.insert(int(offset + begin), text);
+    }
+    return begin + text.size();
+}
+
+bool Completion::isMenuOpen() const
+{
+    return menu_result_ != nullptr;
+}
+
+// What was drawn is erased cell by cell, the rows below the line stay as blank as they were
+void Completion::closeMenu(Terminal &terminal)
+{
+    if (!isMenuOpen())
     {
         return;
     }
+    menu_.clear();
+    menu_.flush(*terminal.io());
+    menu_.resize(0, 0);
+    menu_result_.reset();
+}
+
+Completion::Status Completion::navigateMenu(const Key &key, Line &line, Cursor &cursor, Terminal &terminal)
+{
+    auto count = menu_result_->size();
+    auto none = selected_ == std::string::npos;
+    if (key == Key::Tab)
+    {
+        select(none ? 0 : (selected_ + 1) % count, terminal);
+    }
+    else if (key == Key::ArrowRight || key == Key::ArrowLeft || key == Key::ArrowDown || key == Key::ArrowUp)
+    {
+        auto step = key == Key::ArrowRight || key == Key::ArrowLeft ? 1 : menu_columns_;
+        if (none)
+        {
+            select(0, terminal);
+        }
+        else if ((key == Key::ArrowRight || key == Key::ArrowDown) && selected_ + step < count)
+        {
+            select(selected_ + step, terminal);
+        }
+        else if ((key == Key::ArrowLeft || key == Key::ArrowUp) && selected_ >= step)
+        {
+            select(selected_ - step, terminal);
+        }
+    }
+    else if (key == Key::Enter && !none)
+    {
+        auto word = menu_result_->words[selected_];
+        closeMenu(terminal);
+        auto end = replace(line, menu_begin_, std::min(menu_end_, line.content().size()), word + " ");
+        line.update();
+        cursor.moveTo(line.prompt().length() + end);
+    }
+    else
+    {
+        // any other key closes the menu and does what it does
+        closeMenu(terminal);
+        key_tab_counter_ = 0;
+        return Status::OK;
+    }
+    return Status::CONTINUE;
+}
+
+// Makes room for the menu below the line and draws it there. The rows are taken with newlines,
+// which scroll the screen when the line is at the bottom, and erased before the cursor goes back.
+void Completion::openMenu(Line &line, Terminal &terminal)
+{
+    auto size = terminal.getSize();
+    auto cols = size.cols > 1 ? size.cols - 1 : 79;
+    column_width_ = std::min(std::size_t(longest_word_length_) + 2, cols);
+    for (auto &word : menu_result_->words)
+    {
+        column_width_ = std::max(column_width_, std::min(utf8::columns(word) + 2, cols));
+    }
+    menu_columns_ = std::max<std::size_t>(1, cols / column_width_);
+    auto rows = (menu_result_->size() + menu_columns_ - 1) / menu_columns_;
+    rows = std::min({rows, MENU_ROWS, size.rows > 1 ? size.rows - 1 : MENU_ROWS});
 
-    std::size_t line_size = 0;
-    auto terminal_size = terminal.getSize();
+    auto &io = *terminal.io();
+    io << "\n\r\033[J";
+    for (std::size_t i = 1; i < rows; ++i)
+    {
+        io << "\n";
+    }
+    io << "\033[" << std::uint32_t(rows) << "A";
+    if (line.screenColumn() > 0)
+    {
+        CursorMotion::write(io, {CursorMotion::Kind::Column, 0}, 0, line.screenColumn());
+    }
+    else
+    {
+        line.invalidate();
+    }
 
-    const std::size_t align = 2;
-    const std::size_t word_max_length = result->longest_word_length + align;
+    menu_.resize(rows, cols);
+    drawMenu(terminal);
+}
 
-    std::ostringstream oss;
-    oss << std::endl;
-    for (auto& keyword : result->words)
+// Puts the page of candidates with the selection into the grid, flushing it writes what changed
+void Completion::drawMenu(Terminal &terminal)
+{
+    for (std::size_t row = 0; row < menu_.rows(); ++row)
     {
-        if ((line_size + word_max_length) >= terminal_size.cols)
+        for (std::size_t column = 0; column < menu_columns_; ++column)
         {
-            oss << std::endl;
-            line_size = 0;
+            auto index = (first_row_ + row) * menu_columns_ + column;
+            auto col = column * column_width_;
+            std::size_t taken = 0;
+            if (index < menu_result_->size())
+            {
+                auto style = index == selected_ ? selected_style_ : CellGrid::StyleIndex(0);
+                taken = menu_.put(row, col, menu_result_->words[index], style);
+            }
+            menu_.erase(row, col + taken, column_width_ - taken);
         }
-        line_size += word_max_length;
-        oss << std::left << std::setw(int(word_max_length)) << keyword;
     }
-    oss << std::endl;
+    menu_.flush(*terminal.io());
+}
 
-    terminal.writeText(oss.str());
-}
\ No newline at end of file
+void Completion::select(std::size_t index, Terminal &terminal)
+{
+    selected_ = index;
+    // the page scrolls to keep the selection in it
+    auto row = index / menu_columns_;
+    if (row < first_row_)
+    {
+        first_row_ = row;
+    }
+    else if (row >= first_row_ + menu_.rows())
+    {
+        first_row_ = row - menu_.rows() + 1;
+    }
+    drawMenu(terminal);
+}
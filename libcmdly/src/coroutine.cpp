@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <cmdly/coroutine.h>
+
+using namespace cmdly;
+
+namespace {
+
+thread_local Executor *current_executor = nullptr;
+
+} /* End of anonymous namespace */
+
+Executor::Executor(const std::shared_ptr<Reactor> &reactor) :
+    reactor_(reactor)
+{}
+
+Executor *Executor::current()
+{
+    return current_executor;
+}
+
+const std::shared_ptr<Reactor> &Executor::reactor()
+{
+    return reactor_;
+}
+
+void Executor::spawn(Task<void> task)
+{
+    auto handle = task.handle();
+    tasks_.push_back(std::move(task));
+    schedule(handle);
+}
+
+void Executor::post(std::function<void()> callback)
+{
+    ready_.push_back(std::move(callback));
+}
+
+void Executor::schedule(std::coroutine_handle<> handle)
+{
+    ready_.emplace_back([handle]() { handle.resume(); });
+}
+
+void Executor::run()
+{
+    auto *previous = current_executor;
+    current_executor = this;
+    stopped_ = false;
+
+    try
+    {
+        while (!stopped_)
+        {
+            // callbacks posted meanwhile wait for the next round, so the reactor is not starved
+            auto ready = std::move(ready_);
+            ready_.clear();
+            for (auto &callback : ready)
+            {
+                callback();
+            }
+
+            collectFinishedTasks();
+            if (tasks_.empty() && ready_.empty())
+            {
+                break;
+            }
+            reactor_->poll(ready_.empty() ? std::chrono::milliseconds(-1) : std::chrono::milliseconds(0));
+        }
+    }
+    catch (...)
+    {
+        current_executor = previous;
+        throw;
+    }
+
+    current_executor = previous;
+}
+
+void Executor::stop()
+{
+    stopped_ = true;
+}
+
+Executor::SleepAwaiter Executor::sleep(std::chrono::milliseconds duration)
+{
+    return {*this, duration};
+}
+
+void Executor::SleepAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    auto &executor = executor_;
+    auto timer = std::make_shared<int>(-1);
+    *timer = executor.reactor()->addTimer(duration_, std::chrono::milliseconds(0), [&executor, timer, handle]() {
+        executor.reactor()->removeTimer(*timer);
+        executor.schedule(handle);
+    });
+}
+
+void Executor::collectFinishedTasks()
+{
+    for (auto it = tasks_.begin(); it != tasks_.end();)
+    {
+        if (!it->done())
+        {
+            ++it;
+            continue;
+        }
+        // a failed task stops the executor with its exception
+        auto task = std::move(*it);
+        it = tasks_.erase(it);
+        task.result();
+    }
+}
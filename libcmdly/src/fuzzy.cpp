@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <algorithm>
+#include <bit>
+#include <thread>
+#include <cmdly/fuzzy.h>
+
+using namespace cmdly;
+
+std::vector<FuzzyMatcher::Match> FuzzyMatcher::search(std::string_view query, std::size_t limit, std::size_t threads) const
+{
+    std::vector<Match> best;
+    if (limit == 0 || words_.empty())
+    {
+        return best;
+    }
+
+    // smart case: a query in lower case only matches letters of any case
+    bool fold = std::none_of(query.begin(), query.end(), [](char c) { return c >= 'A' && c <= 'Z'; });
+    std::string folded(query);
+    if (fold)
+    {
+        std::transform(folded.begin(), folded.end(), folded.begin(), lower);
+    }
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, std::max<std::size_t>(1, words_.size() / (PARALLEL_THRESHOLD / 2)));
+    if (words_.size() < PARALLEL_THRESHOLD || threads < 2)
+    {
+        scan(folded, fold, 0, words_.size(), limit, best);
+    }
+    else
+    {
+        // every worker keeps the best of its slice, the calling thread takes the first one
+        auto slice = (words_.size() + threads - 1) / threads;
+        std::vector<std::vector<Match>> results(threads);
+        std::vector<std::thread> workers;
+        for (std::size_t i = 1; i < threads; ++i)
+        {
+            workers.emplace_back([&, i]() {
+                scan(folded, fold, i * slice, std::min(words_.size(), (i + 1) * slice), limit, results[i]);
+            });
+        }
+        scan(folded, fold, 0, slice, limit, results[0]);
+        for (auto &worker : workers)
+        {
+            worker.join();
+        }
+        for (auto &result : results)
+        {
+            best.insert(best.end(), result.begin(), result.end());
+        }
+    }
+
+    // no more than threads * limit matches are left to order
+    auto by_rank = [this](const Match &match1, const Match &match2) { return better(match1, match2); };
+    auto count = std::min(limit, best.size());
+    std::partial_sort(best.begin(), best.begin() + std::ptrdiff_t(count), best.end(), by_rank);
+    best.resize(count);
+    return best;
+}
+
+bool FuzzyMatcher::better(const Match &match1, const Match &match2) const
+{
+    if (match1.score != match2.score)
+    {
+        return match1.score > match2.score;
+    }
+    auto &word1 = words_[match1.index];
+    auto &word2 = words_[match2.index];
+    if (word1.size() != word2.size())
+    {
+        return word1.size() < word2.size();
+    }
+    return word1 < word2;
+}
+
+// Masks are compared 64 words at a time into a bitmask of candidates, a loop the compiler turns into
+// vector instructions; only the candidates are scored. The best matches are kept in a heap with the
+// worst of them on top, so a match that does not make it costs a single comparison.
+void FuzzyMatcher::scan(std::string_view query, bool fold, std::size_t begin, std::size_t end, std::size_t limit,
+                        std::vector<Match> &best) const
+{
+    constexpr std::size_t BLOCK = 64;
+    auto needed = mask(query);
+    auto by_rank = [this](const Match &match1, const Match &match2) { return better(match1, match2); };
+    best.reserve(limit);
+    for (auto block = begin; block < end; block += BLOCK)
+    {
+        auto count = std::min(BLOCK, end - block);
+        const auto *masks = masks_.data() + block;
+        std::uint64_t candidates = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            candidates |= std::uint64_t((masks[i] & needed) == needed) << i;
+        }
+        for (; candidates != 0; candidates &= candidates - 1)
+        {
+            auto index = block + std::size_t(std::countr_zero(candidates));
+            auto score = FuzzyMatcher::score(words_[index], query, fold);
+            if (score == NO_MATCH)
+            {
+                continue;
+            }
+            Match match{std::uint32_t(index), score};
+            if (best.size() < limit)
+            {
+                best.push_back(match);
+                std::push_heap(best.begin(), best.end(), by_rank);
+            }
+            else if (better(match, best.front()))
+            {
+                std::pop_heap(best.begin(), best.end(), by_rank);
+                best.back() = match;
+                std::push_heap(best.begin(), best.end(), by_rank);
+            }
+        }
+    }
+}
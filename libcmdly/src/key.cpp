@@ -20,4 +20,9 @@ Key Key::Home = Key("^[H");
 Key Key::F1 = Key("^OP");
 Key Key::F2 = Key("^OQ");
 Key Key::F3 = Key("^OR");
-Key Key::F4 = Key("^OS");
\ No newline at end of file
+Key Key::F4 = Key("^OS");
+Key Key::Paste = Key("^[200~");
+// not sent by terminals, reported when the window size changed
+Key Key::Resize = Key("<resize>");
+// not sent by terminals, reported when another thread woke up the reader
+Key Key::WakeUp = Key("<wakeup>");
\ No newline at end of file
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <unistd.h>
+#include <sys/timerfd.h>
+#include <cerrno>
+#include <cmdly/reactor.h>
+
+using namespace cmdly;
+
+namespace {
+
+struct timespec toTimespec(std::chrono::milliseconds ms)
+{
+    struct timespec ts{};
+    ts.tv_sec = ms.count() / 1000;
+    ts.tv_nsec = (ms.count() % 1000) * 1000000;
+    return ts;
+}
+
+} /* End of anonymous namespace */
+
+Reactor::Reactor() :
+    epoll_fd_(::epoll_create1(EPOLL_CLOEXEC))
+{
+    if (epoll_fd_ < 0)
+    {
+        throw IOError("could not create epoll instance");
+    }
+}
+
+Reactor::~Reactor()
+{
+    ::close(epoll_fd_);
+}
+
+void Reactor::add(int fd, std::uint32_t events, const Handler &handler)
+{
+    struct epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        throw IOError("could not add descriptor to reactor");
+    }
+    handlers_[fd] = std::make_shared<Handler>(handler);
+}
+
+void Reactor::modify(int fd, std::uint32_t events)
+{
+    struct epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event) < 0)
+    {
+        throw IOError("could not modify descriptor in reactor");
+    }
+}
+
+void Reactor::remove(int fd)
+{
+    if (handlers_.erase(fd) == 0)
+    {
+        return;
+    }
+    ::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+}
+
+bool Reactor::contains(int fd) const
+{
+    return handlers_.count(fd) > 0;
+}
+
+int Reactor::addTimer(std::chrono::milliseconds delay, std::chrono::milliseconds interval, const TimerHandler &handler)
+{
+    int fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (fd < 0)
+    {
+        throw IOError("could not create timer");
+    }
+
+    struct itimerspec spec{};
+    spec.it_value = toTimespec(delay.count() > 0 ? delay : std::chrono::milliseconds(1));
+    spec.it_interval = toTimespec(interval);
+    if (::timerfd_settime(fd, 0, &spec, nullptr) < 0)
+    {
+        ::close(fd);
+        throw IOError("could not arm timer");
+    }
+
+    add(fd, EPOLLIN, [fd, handler](std::uint32_t) {
+        std::uint64_t expirations = 0;
+        if (::read(fd, &expirations, sizeof(expirations)) == sizeof(expirations))
+        {
+            handler();
+        }
+    });
+    return fd;
+}
+
+void Reactor::removeTimer(int fd)
+{
+    remove(fd);
+    ::close(fd);
+}
+
+std::size_t Reactor::poll(std::chrono::milliseconds timeout)
+{
+    struct epoll_event events[MAX_EVENTS];
+    int count = ::epoll_wait(epoll_fd_, events, MAX_EVENTS, int(timeout.count()));
+    if (count < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        throw IOError("could not wait for events");
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        // a handler may remove any descriptor, including its own
+        auto it = handlers_.find(events[i].data.fd);
+        if (it == handlers_.end())
+        {
+            continue;
+        }
+        auto handler = it->second;
+        (*handler)(events[i].events);
+    }
+
+    return std::size_t(count);
+}
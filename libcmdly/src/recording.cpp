@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <cstring>
+#include <thread>
+#include <cmdly/recording.h>
+
+using namespace cmdly;
+
+namespace {
+
+// Bytes a terminal sends for the key, pseudo keys have none
+std::string encodeKey(const Key &key)
+{
+    if (key.isPaste())
+    {
+        return std::string(KeyDecoder::PASTE_BEGIN) + std::string(key.text()) + std::string(KeyDecoder::PASTE_END);
+    }
+    if (key == Key::Resize)
+    {
+        return "";
+    }
+    if (key.isSpecial())
+    {
+        return key.sequence();
+    }
+    return std::string(1, key.code());
+}
+
+template<typename T>
+void writeValue(std::ostream &out, T value)
+{
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template<typename T>
+bool readValue(std::istream &in, T *value)
+{
+    return bool(in.read(reinterpret_cast<char *>(value), sizeof(T)));
+}
+
+} /* End of anonymous namespace */
+
+void SessionLog::writeHeader(std::ostream &out, const Header &header)
+{
+    out.write(MAGIC.data(), std::streamsize(MAGIC.size()));
+    writeValue<std::uint8_t>(out, VERSION);
+    writeValue<std::uint8_t>(out, header.interactive ? 1 : 0);
+}
+
+void SessionLog::writeEvent(std::ostream &out, const SessionEvent &event)
+{
+    writeValue<std::int64_t>(out, event.time.count());
+    writeValue<std::uint8_t>(out, static_cast<std::uint8_t>(event.type));
+    writeValue<std::uint32_t>(out, std::uint32_t(event.data.size()));
+    out.write(event.data.data(), std::streamsize(event.data.size()));
+}
+
+std::vector<SessionEvent> SessionLog::load(const std::string &path, Header *header)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        throw IOError("could not open session log " + path);
+    }
+
+    char magic[MAGIC.size()];
+    std::uint8_t version = 0;
+    std::uint8_t interactive = 0;
+    if (!in.read(magic, sizeof(magic)) || std::string_view(magic, sizeof(magic)) != MAGIC ||
+        !readValue(in, &version) || version != VERSION || !readValue(in, &interactive))
+    {
+        throw IOError("not a session log: " + path);
+    }
+    if (header != nullptr)
+    {
+        header->interactive = interactive != 0;
+    }
+
+    std::vector<SessionEvent> events;
+    std::int64_t time;
+    while (readValue(in, &time))
+    {
+        std::uint8_t type;
+        std::uint32_t length;
+        if (!readValue(in, &type) || !readValue(in, &length))
+        {
+            throw IOError("truncated session log: " + path);
+        }
+        std::string data(length, '\0');
+        if (!in.read(data.data(), length))
+        {
+            throw IOError("truncated session log: " + path);
+        }
+        events.push_back({std::chrono::nanoseconds(time), static_cast<SessionEvent::Type>(type), std::move(data)});
+    }
+    return events;
+}
+
+std::string SessionLog::encodeSize(std::size_t cols, std::size_t rows)
+{
+    std::uint32_t size[2] = {std::uint32_t(cols), std::uint32_t(rows)};
+    return std::string(reinterpret_cast<const char *>(size), sizeof(size));
+}
+
+void SessionLog::decodeSize(std::string_view data, std::size_t *cols, std::size_t *rows)
+{
+    std::uint32_t size[2] = {0, 0};
+    std::memcpy(size, data.data(), std::min(data.size(), sizeof(size)));
+    *cols = size[0];
+    *rows = size[1];
+}
+
+RecordingIO::RecordingIO(std::shared_ptr<IO> io, const std::string &path) :
+    io_(std::move(io)), log_(path, std::ios::binary | std::ios::trunc), start_(std::chrono::steady_clock::now())
+{
+    if (!log_)
+    {
+        throw IOError("could not create session log " + path);
+    }
+    SessionLog::writeHeader(log_, {io_->isInteractive()});
+    recordSize();
+}
+
+Key RecordingIO::getKey()
+{
+    // output collected so far must be written (and recorded) before blocking on input
+    flush();
+    auto key = io_->getKey();
+    if (key == Key::Resize)
+    {
+        recordSize();
+    }
+    else
+    {
+        record(SessionEvent::Type::Input, encodeKey(key));
+    }
+    return key;
+}
+
+char RecordingIO::getChar()
+{
+    char c = io_->getChar();
+    record(SessionEvent::Type::Input, std::string_view(&c, 1));
+    return c;
+}
+
+void RecordingIO::write(const std::string &data) const
+{
+    io_->write(data);
+    record(SessionEvent::Type::Output, data);
+}
+
+void RecordingIO::getWindowSize(std::size_t *cols, std::size_t *rows) const
+{
+    io_->getWindowSize(cols, rows);
+}
+
+void RecordingIO::enterRawMode()
+{
+    io_->enterRawMode();
+}
+
+void RecordingIO::exitRawMode()
+{
+    io_->exitRawMode();
+}
+
+bool RecordingIO::isInteractive() const
+{
+    return io_->isInteractive();
+}
+
+int RecordingIO::inputDescriptor() const
+{
+    return io_->inputDescriptor();
+}
+
+bool RecordingIO::waitForInput(std::chrono::milliseconds timeout)
+{
+    return io_->waitForInput(timeout);
+}
+
+std::optional<std::string> RecordingIO::readAvailable()
+{
+    auto data = io_->readAvailable();
+    if (data && !data->empty())
+    {
+        record(SessionEvent::Type::Input, *data);
+    }
+    return data;
+}
+
+int RecordingIO::resizeDescriptor() const
+{
+    return io_->resizeDescriptor();
+}
+
+bool RecordingIO::checkResize()
+{
+    if (!io_->checkResize())
+    {
+        return false;
+    }
+    recordSize();
+    return true;
+}
+
+void RecordingIO::record(SessionEvent::Type type, std::string_view data) const
+{
+    auto time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+    SessionLog::writeEvent(log_, {time, type, std::string(data)});
+    // the log is flushed with every input, so it survives a crash of the session being recorded
+    if (type != SessionEvent::Type::Output)
+    {
+        log_.flush();
+    }
+}
+
+void RecordingIO::recordSize()
+{
+    std::size_t cols, rows;
+    io_->getWindowSize(&cols, &rows);
+    record(SessionEvent::Type::Resize, SessionLog::encodeSize(cols, rows));
+}
+
+ReplayIO::ReplayIO(const std::string &path, Speed speed) :
+    speed_(speed), start_(std::chrono::steady_clock::now())
+{
+    SessionLog::Header header;
+    events_ = SessionLog::load(path, &header);
+    interactive_ = header.interactive;
+
+    // the size at the start of the session is known before any input
+    if (!events_.empty() && events_.front().type == SessionEvent::Type::Resize)
+    {
+        SessionLog::decodeSize(events_.front().data, &cols_, &rows_);
+        next_event_ = 1;
+    }
+}
+
+Key ReplayIO::getKey()
+{
+    flush();
+    endTiming();
+    for (;;)
+    {
+        if (auto key = decoder_.next())
+        {
+            beginTiming();
+            return *key;
+        }
+        // keys were recorded one by one, so what is left of an event is a key on its own (e.g. <ESC>)
+        if (auto key = decoder_.flush())
+        {
+            beginTiming();
+            return *key;
+        }
+
+        auto event = nextInput();
+        if (event == nullptr)
+        {
+            return Key::Ctrl('d');
+        }
+        if (event->type == SessionEvent::Type::Resize)
+        {
+            SessionLog::decodeSize(event->data, &cols_, &rows_);
+            beginTiming();
+            return Key::Resize;
+        }
+        decoder_.feed(event->data);
+    }
+}
+
+char ReplayIO::getChar()
+{
+    while (decoder_.empty())
+    {
+        auto event = nextInput();
+        if (event == nullptr)
+        {
+            return -1;
+        }
+        decoder_.feed(event->data);
+    }
+    return *decoder_.takeByte();
+}
+
+void ReplayIO::write(const std::string &data) const
+{
+    output_bytes_ += data.size();
+}
+
+void ReplayIO::getWindowSize(std::size_t *cols, std::size_t *rows) const
+{
+    *cols = cols_;
+    *rows = rows_;
+}
+
+bool ReplayIO::isInteractive() const
+{
+    return interactive_;
+}
+
+bool ReplayIO::waitForInput(std::chrono::milliseconds)
+{
+    return !finished();
+}
+
+std::optional<std::string> ReplayIO::readAvailable()
+{
+    flush();
+    endTiming();
+    if (!decoder_.empty())
+    {
+        beginTiming();
+        return decoder_.takeAll();
+    }
+    for (;;)
+    {
+        auto event = nextInput();
+        if (event == nullptr)
+        {
+            return std::nullopt;
+        }
+        if (event->type == SessionEvent::Type::Input)
+        {
+            beginTiming();
+            return event->data;
+        }
+        SessionLog::decodeSize(event->data, &cols_, &rows_);
+    }
+}
+
+const std::vector<ReplayIO::Timing> &ReplayIO::timings()
+{
+    flush();
+    endTiming();
+    return timings_;
+}
+
+bool ReplayIO::finished() const
+{
+    if (!decoder_.empty())
+    {
+        return false;
+    }
+    for (auto i = next_event_; i < events_.size(); ++i)
+    {
+        if (events_[i].type != SessionEvent::Type::Output)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const SessionEvent *ReplayIO::nextInput()
+{
+    while (next_event_ < events_.size() && events_[next_event_].type == SessionEvent::Type::Output)
+    {
+        next_event_++;
+    }
+    if (next_event_ == events_.size())
+    {
+        return nullptr;
+    }
+
+    current_event_ = next_event_++;
+    auto &event = events_[current_event_];
+    if (speed_ == Speed::Original)
+    {
+        std::this_thread::sleep_until(start_ + event.time);
+    }
+    return &event;
+}
+
+void ReplayIO::beginTiming()
+{
+    timing_ = true;
+    output_bytes_ = 0;
+    timing_begin_ = std::chrono::steady_clock::now();
+}
+
+void ReplayIO::endTiming()
+{
+    if (!timing_)
+    {
+        return;
+    }
+    timing_ = false;
+    auto processing = std::chrono::steady_clock::now() - timing_begin_;
+    timings_.push_back({current_event_, events_[current_event_].time,
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(processing), output_bytes_});
+}
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <cmdly/server.h>
+
+using namespace cmdly;
+
+SocketIO::SocketIO(int fd, std::size_t cols, std::size_t rows) :
+    fd_(fd), cols_(cols), rows_(rows)
+{}
+
+SocketIO::~SocketIO()
+{
+    ::close(fd_);
+}
+
+Key SocketIO::getKey()
+{
+    flush();
+    for (;;)
+    {
+        if (auto key = decoder_.next())
+        {
+            return *key;
+        }
+        if (!waitInput(decoder_.pending() ? ESC_TIMEOUT : std::chrono::milliseconds(-1)))
+        {
+            // the sequence left pending is taken as it is
+            if (auto key = decoder_.flush())
+            {
+                return *key;
+            }
+            continue;
+        }
+        if (!fill())
+        {
+            if (auto key = decoder_.flush())
+            {
+                return *key;
+            }
+            return Key::Ctrl('d');
+        }
+    }
+}
+
+char SocketIO::getChar()
+{
+    flush();
+    while (decoder_.empty())
+    {
+        waitInput(std::chrono::milliseconds(-1));
+        if (!fill())
+        {
+            return -1;
+        }
+    }
+    return *decoder_.takeByte();
+}
+
+std::optional<std::string> SocketIO::readAvailable()
+{
+    if (!decoder_.empty())
+    {
+        return decoder_.takeAll();
+    }
+    if (!fill())
+    {
+        return std::nullopt;
+    }
+    return decoder_.takeAll();
+}
+
+// Waits until the peer sent something, false on timeout
+bool SocketIO::waitInput(std::chrono::milliseconds timeout) const
+{
+    struct pollfd pfd = {fd_, POLLIN, 0};
+    int retval;
+    do
+    {
+        retval = ::poll(&pfd, 1, int(timeout.count()));
+    }
+    while (retval < 0 && errno == EINTR);
+    return retval != 0;
+}
+
+// Reads what the socket has into the decoder without blocking, false at the end of input
+bool SocketIO::fill()
+{
+    char buf[READ_BUFFER_SIZE];
+    ssize_t len;
+    do
+    {
+        len = ::recv(fd_, buf, sizeof(buf), MSG_DONTWAIT);
+        statistics_.reads++;
+    }
+    while (len < 0 && errno == EINTR);
+    if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+        return true;
+    }
+    if (len <= 0)
+    {
+        return false;
+    }
+    statistics_.bytes_read += std::size_t(len);
+    decoder_.feed(std::string_view(buf, std::size_t(len)));
+    return true;
+}
+
+void SocketIO::write(const std::string &data) const
+{
+    if (pending_.empty())
+    {
+        send(data);
+        return;
+    }
+    if (pending_.size() + data.size() > OUTPUT_LIMIT)
+    {
+        // the peer stopped reading, it gets disconnected and the session ends on the EOF
+        ::shutdown(fd_, SHUT_RDWR);
+        pending_.clear();
+        return;
+    }
+    pending_.append(data);
+}
+
+void SocketIO::getWindowSize(std::size_t *cols, std::size_t *rows) const
+{
+    *cols = cols_;
+    *rows = rows_;
+}
+
+void SocketIO::setWindowSize(std::size_t cols, std::size_t rows)
+{
+    cols_ = cols;
+    rows_ = rows;
+}
+
+bool SocketIO::flushPending()
+{
+    if (pending_.empty())
+    {
+        return true;
+    }
+    std::string data;
+    data.swap(pending_);
+    return send(data);
+}
+
+// Sends what the socket takes now, the rest is kept; false when something was kept
+bool SocketIO::send(std::string_view data) const
+{
+    std::size_t offset = 0;
+    while (offset < data.size())
+    {
+        auto len = ::send(fd_, data.data() + offset, data.size() - offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+        statistics_.writes++;
+        if (len > 0)
+        {
+            statistics_.bytes_written += len;
+            offset += len;
+            continue;
+        }
+        if (len < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (len < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && data.size() - offset <= OUTPUT_LIMIT)
+        {
+            bool was_empty = pending_.empty();
+            pending_.assign(data.substr(offset));
+            if (was_empty && blocked_handler_)
+            {
+                blocked_handler_();
+            }
+            return false;
+        }
+        // the peer is gone (or would take too long), reading ends with EOF then
+        ::shutdown(fd_, SHUT_RDWR);
+        return true;
+    }
+    return true;
+}
+
+SessionServer::SessionServer(std::string path, SetupHandler setup, Options options) :
+    path_(std::move(path)), setup_(std::move(setup)), options_(std::move(options))
+{}
+
+SessionServer::SessionServer(std::string path, SetupHandler setup) :
+    SessionServer(std::move(path), std::move(setup), Options())
+{}
+
+SessionServer::~SessionServer()
+{
+    stop();
+}
+
+void SessionServer::start()
+{
+    if (running_)
+    {
+        return;
+    }
+
+    struct sockaddr_un address{};
+    if (path_.size() >= sizeof(address.sun_path))
+    {
+        throw IOError("socket path too long: " + path_);
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path_.c_str(), sizeof(address.sun_path) - 1);
+
+    listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd_ < 0)
+    {
+        throw IOError("could not create socket");
+    }
+    ::unlink(path_.c_str());
+    if (::bind(listen_fd_, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) < 0 ||
+        ::listen(listen_fd_, SOMAXCONN) < 0)
+    {
+        ::close(listen_fd_);
+        listen_fd_ = -1;
+        throw IOError("could not listen on " + path_);
+    }
+
+    running_ = true;
+    for (std::size_t i = 0; i < std::max<std::size_t>(options_.threads, 1); ++i)
+    {
+        auto worker = std::make_unique<Worker>();
+        worker->reactor = std::make_shared<Reactor>();
+        // every worker waits for connections, EPOLLEXCLUSIVE wakes up only one of them
+        worker->reactor->add(listen_fd_, EPOLLIN | EPOLLEXCLUSIVE, [this, &worker = *worker](std::uint32_t) {
+            accept(worker);
+        });
+        worker->thread = std::thread(&SessionServer::serve, this, std::ref(*worker));
+        workers_.push_back(std::move(worker));
+    }
+}
+
+void SessionServer::stop()
+{
+    if (!running_)
+    {
+        return;
+    }
+
+    running_ = false;
+    for (auto &worker : workers_)
+    {
+        worker->thread.join();
+    }
+    workers_.clear();
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    ::unlink(path_.c_str());
+}
+
+void SessionServer::serve(Worker &worker)
+{
+    while (running_)
+    {
+        worker.reactor->poll(std::chrono::milliseconds(100));
+        closeSessions(worker);
+    }
+
+    session_count_ -= worker.sessions.size();
+    for (auto &session : worker.sessions)
+    {
+        unwatchOutput(worker, session.second);
+    }
+    worker.sessions.clear();
+}
+
+void SessionServer::accept(Worker &worker)
+{
+    for (;;)
+    {
+        int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            return;
+        }
+        // sessions are counted before they are made, so workers accepting at once stay within the limit
+        if (session_count_.fetch_add(1) >= options_.max_sessions)
+        {
+            session_count_--;
+            ::close(fd);
+            continue;
+        }
+
+        auto &session = worker.sessions[fd];
+        session.io = std::make_shared<SocketIO>(fd);
+        session.terminal = std::make_unique<Terminal>(session.io,
+                                                      std::make_shared<MemoryHistory>(options_.history_limit));
+        session.io->onBlocked([this, &worker, fd]() { watchOutput(worker, fd); });
+        session.terminal->onStop([&worker, fd](Terminal &) { worker.closed.push_back(fd); });
+        session.terminal->setReactor(worker.reactor);
+
+        setup_(*session.terminal);
+        session.terminal->start(options_.prompt);
+    }
+}
+
+// Kept output is sent when the socket has room for it again. The socket itself is watched for input
+// by the terminal, so room to write is watched for on a duplicate of it.
+void SessionServer::watchOutput(Worker &worker, int fd)
+{
+    auto it = worker.sessions.find(fd);
+    if (it == worker.sessions.end() || it->second.writable >= 0)
+    {
+        return;
+    }
+    auto &session = it->second;
+    session.writable = ::dup(fd);
+    if (session.writable < 0)
+    {
+        throw IOError("could not watch session output");
+    }
+    worker.reactor->add(session.writable, EPOLLOUT, [&worker, fd](std::uint32_t) {
+        auto it = worker.sessions.find(fd);
+        if (it != worker.sessions.end() && it->second.io->flushPending())
+        {
+            unwatchOutput(worker, it->second);
+        }
+    });
+}
+
+void SessionServer::unwatchOutput(Worker &worker, Session &session)
+{
+    if (session.writable < 0)
+    {
+        return;
+    }
+    worker.reactor->remove(session.writable);
+    ::close(std::exchange(session.writable, -1));
+}
+
+// Sessions are destroyed here rather than from their own stop handler
+void SessionServer::closeSessions(Worker &worker)
+{
+    for (int fd : worker.closed)
+    {
+        auto session = worker.sessions.find(fd);
+        if (session == worker.sessions.end())
+        {
+            continue;
+        }
+        session->second.io->flushPending();
+        unwatchOutput(worker, session->second);
+        worker.sessions.erase(session);
+        session_count_--;
+    }
+    worker.closed.clear();
+}
@@ -6,15 +6,51 @@
 
 using namespace cmdly;
 
+namespace {
+
+// Keeps only what can be put into a single line, line breaks and tabs become spaces
+std::string sanitizePaste(std::string_view text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text)
+    {
+        auto b = static_cast<unsigned char>(c);
+        if (c == '\n' || c == '\r' || c == '\t')
+        {
+            result.push_back(' ');
+        }
+        else if (std::isprint(b) || b >= 0x80)
+        {
+            result.push_back(c);
+        }
+    }
+    return result;
+}
+
+} /* End of anonymous namespace */
+
 Terminal::Terminal(const std::shared_ptr<IO> &io,
                    const std::shared_ptr<History> &history,
                    const std::shared_ptr<Completion> &completion) :
-    io_(io), history_(history), completion_(completion)
+    io_(io), history_(history), completion_(completion), commands_(std::make_shared<CommandTree>())
 {
+    completion_->setCommands(commands_);
     registerDefaultKeyListeners();
     registerDefaultLineEnteredListeners();
 }
 
+Terminal::~Terminal()
+{
+    try
+    {
+        processing_ = false;
+        stop();
+    }
+    catch (const IOError &)
+    {}
+}
+
 const std::shared_ptr<IO> &Terminal::io()
 {
     return io_;
@@ -30,6 +66,11 @@ const std::shared_ptr<Completion> &Terminal::completion()
     return completion_;
 }
 
+const std::shared_ptr<CommandTree> &Terminal::commands()
+{
+    return commands_;
+}
+
 void Terminal::onKeyPressed(const Key &key, const KeyPressedListener::FunctionType &handler)
 {
     addKeyPressedListener(key, std::make_shared<KeyPressedListenerFunctionWrapper>(handler));
@@ -102,7 +143,7 @@ const TextStyle& Terminal::getLineStyle() const
 void Terminal::setCursorStyle(const CursorStyle &style)
 {
     cursor_style_ = style;
-    *io_ << cursor_style_.str();
+    *io_ << cursor_style_.view();
 }
 
 const CursorStyle& Terminal::getCursorStyle()
@@ -117,8 +158,48 @@ void Terminal::resetStyle()
     setCursorStyle(CursorStyle::Default);
 }
 
+void Terminal::setHorizontalScroll(bool enabled)
+{
+    horizontal_scroll_ = enabled;
+    if (line_)
+    {
+        line_->setViewport(enabled ? getSize().cols : 0);
+        line_->update();
+        cursor_->sync();
+    }
+}
+
+void Terminal::setAutosuggest(bool enabled)
+{
+    autosuggest_ = enabled;
+    if (line_ && !enabled)
+    {
+        line_->hideSuggestion();
+        cursor_->sync();
+    }
+}
+
+void Terminal::setHighlighter(const std::shared_ptr<Highlighter> &highlighter)
+{
+    highlighter_ = highlighter;
+    if (line_)
+    {
+        line_->setHighlighter(highlighter_);
+        line_->update();
+        cursor_->sync();
+    }
+}
+
 void Terminal::run(const std::string &prompt)
 {
+    if (!io_->isInteractive())
+    {
+        runBatch();
+        return;
+    }
+
+    RawMode raw_mode(*io_);
+
     for (;;)
     {
         auto content = readLine(prompt);
@@ -131,59 +212,282 @@ void Terminal::run(const std::string &prompt)
 
 std::string Terminal::readLine(const std::string &prompt)
 {
-    Line line(prompt, prompt_style_, line_style_, io_);
-    Cursor cursor(line, io_);
-    std::string content;
+    RawMode raw_mode(*io_);
+    beginLine(prompt);
 
-    for (;;)
+    try
+    {
+        for (;;)
+        {
+            auto key = io_->getKey();
+            Frame frame(*io_);
+            if (processKey(key))
+            {
+                break;
+            }
+        }
+    }
+    catch (...)
     {
-        auto key = io_->getKey();
+        abortLine();
+        throw;
+    }
 
-        auto key_status = handleKeyPressed(key, line, cursor);
-        if (key_status == KeyPressedListener::Status::CONTINUE) { continue; }
-        if (key_status == KeyPressedListener::Status::BREAK) { break; }
+    return endLine();
+}
 
-        if (key.isPrintable())
+// Lines go straight to the listeners: no raw mode, no prompt, no editing and output of a whole read in one write
+void Terminal::runBatch()
+{
+    batch_ = true;
+    try
+    {
+        std::string pending;
+        for (;;)
         {
-            cursor.putChar(key.code());
-            if (history_->isManipulated())
+            auto data = io_->readAvailable();
+            if (!data)
             {
-                history_->rewind();
+                break;
             }
+
+            Frame frame(*io_);
+            pending.append(*data);
+            std::size_t begin = 0;
+            std::size_t end;
+            while ((end = pending.find('\n', begin)) != std::string::npos)
+            {
+                if (!processBatchLine(pending.substr(begin, end - begin)))
+                {
+                    batch_ = false;
+                    return;
+                }
+                begin = end + 1;
+            }
+            pending.erase(0, begin);
+            drainPostedText();
+        }
+
+        if (!pending.empty())
+        {
+            Frame frame(*io_);
+            processBatchLine(pending);
         }
+    }
+    catch (...)
+    {
+        batch_ = false;
+        throw;
+    }
+    batch_ = false;
+}
 
-        if (content == line.content()) { continue; }
+bool Terminal::processBatchLine(std::string content)
+{
+    content = string::trim(content);
+    return handleLineEntered(content) != LineEnteredListener::Status::BREAK;
+}
 
-        content = line.content();
-        auto line_status = handleLineChanged(content, line, cursor);
-        if (line_status == LineChangedListener::Status::CONTINUE) { continue; }
-        if (line_status == LineChangedListener::Status::BREAK) { break; }
+void Terminal::start(const std::string &prompt)
+{
+    if (running_)
+    {
+        return;
     }
 
-    content = line.content();
-    history_->insert(content);
-    history_->rewind();
+    startInput();
+    auto_prompt_ = true;
+    prompt_ = prompt;
+    beginLine(prompt_);
+}
 
-    return content;
+void Terminal::stop()
+{
+    if (!running_)
+    {
+        return;
+    }
+    if (processing_)
+    {
+        stop_requested_ = true;
+        return;
+    }
+
+    stopInput();
+    if (line_)
+    {
+        abortLine();
+    }
+    decoder_.clear();
+    resumeWaiters();
+    if (stop_handler_)
+    {
+        stop_handler_(*this);
+    }
+}
+
+void Terminal::onStop(const std::function<void(Terminal &)> &handler)
+{
+    stop_handler_ = handler;
+}
+
+bool Terminal::isRunning() const
+{
+    return running_;
+}
+
+void Terminal::feed(std::string_view data)
+{
+    if (!running_)
+    {
+        return;
+    }
+    decoder_.feed(data);
+    processFedInput(false);
+}
+
+bool Terminal::pollOnce(std::chrono::milliseconds timeout)
+{
+    if (!running_)
+    {
+        return false;
+    }
+
+    if (decoder_.pending())
+    {
+        auto left = std::chrono::duration_cast<std::chrono::milliseconds>(esc_deadline_ - std::chrono::steady_clock::now());
+        left = std::max(left, std::chrono::milliseconds(0));
+        timeout = timeout.count() < 0 ? left : std::min(timeout, left);
+    }
+
+    reactor()->poll(timeout);
+
+    // a lonely <ESC> waited long enough, it is a key on its own
+    if (running_ && decoder_.pending() && std::chrono::steady_clock::now() >= esc_deadline_)
+    {
+        processFedInput(true);
+    }
+
+    return running_;
+}
+
+Terminal::LineAwaiter Terminal::readLineAsync(const std::string &prompt)
+{
+    return {*this, prompt};
+}
+
+Terminal::KeyAwaiter Terminal::nextKeyAsync()
+{
+    return KeyAwaiter(*this);
+}
+
+void Terminal::LineAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    auto &executor = currentExecutor();
+    handle_ = handle;
+    terminal_.line_waiter_ = this;
+    if (!terminal_.running_)
+    {
+        terminal_.startInput();
+    }
+    if (!terminal_.line_)
+    {
+        Frame frame(*terminal_.io_);
+        terminal_.beginLine(prompt_);
+    }
+    // keys typed ahead wait in the decoder
+    if (!terminal_.decoder_.empty())
+    {
+        executor.post([&terminal = terminal_]() { terminal.processFedInput(false); });
+    }
+}
+
+void Terminal::KeyAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    auto &executor = currentExecutor();
+    handle_ = handle;
+    terminal_.key_waiter_ = this;
+    if (!terminal_.running_)
+    {
+        terminal_.startInput();
+    }
+    if (!terminal_.decoder_.empty())
+    {
+        executor.post([&terminal = terminal_]() { terminal.processFedInput(false); });
+    }
+}
+
+Executor &Terminal::currentExecutor()
+{
+    auto *executor = Executor::current();
+    if (executor == nullptr)
+    {
+        throw CmdlyError("awaiting terminal requires a running executor");
+    }
+    return *executor;
+}
+
+const std::shared_ptr<Reactor> &Terminal::reactor()
+{
+    if (!reactor_)
+    {
+        reactor_ = std::make_shared<Reactor>();
+    }
+    return reactor_;
+}
+
+void Terminal::setReactor(const std::shared_ptr<Reactor> &reactor)
+{
+    reactor_ = reactor;
+}
+
+void Terminal::setEscTimeout(std::chrono::milliseconds timeout)
+{
+    esc_timeout_ = timeout;
 }
 
 void Terminal::writeText(const std::string &text, const TextStyle &text_style)
 {
-    if (text_style == TextStyle::Default)
+    completion_->closeMenu(*this);
+    if (line_)
+    {
+        line_->hideSuggestion();
+        line_->invalidate();
+    }
+    if (text_style == TextStyle::Default || batch_)
     {
         *io_ << text;
         return;
     }
-    *io_ << text_style.str() << text << "\033[m";
+    Frame frame(*io_);
+    *io_ << text_style.view() << text << "\033[m";
+}
+
+void Terminal::postText(const std::string &text, const TextStyle &text_style)
+{
+    posted_.push(text_style == TextStyle::Default ? text : text_style.str() + text + "\033[m");
+    // one wake-up is enough for everything posted until the queue is drained
+    if (!wake_pending_.exchange(true))
+    {
+        io_->wakeUp();
+    }
 }
 
 void Terminal::bell()
 {
+    if (batch_)
+    {
+        return;
+    }
     *io_ << "\a";
 }
 
 void Terminal::clearCurrentLine()
 {
+    if (batch_)
+    {
+        return;
+    }
     *io_ << "\033[K";
 }
 
@@ -196,6 +500,12 @@ Terminal::Size Terminal::getSize()
 
 void Terminal::registerDefaultKeyListeners()
 {
+    // an open completion menu takes the keys moving in it before the line does
+    for (const auto &key : {Key::Enter, Key::ArrowUp, Key::ArrowDown, Key::ArrowLeft, Key::ArrowRight})
+    {
+        addKeyPressedListener(key, completion_);
+    }
+
     onKeyPressed(Key::Enter, [](const Key &, Line &, Cursor &, Terminal &terminal) {
         terminal.writeText("\n");
         return KeyPressedListener::Status::BREAK;
@@ -216,7 +526,15 @@ void Terminal::registerDefaultKeyListeners()
         return KeyPressedListener::Status::CONTINUE;
     });
 
-    onKeyPressed(Key::ArrowRight, [](const Key &, Line &, Cursor &cursor, Terminal &) {
+    onKeyPressed(Key::ArrowRight, [](const Key &, Line &line, Cursor &cursor, Terminal &) {
+        // at the end of the line there is nothing to move over, the suggestion is taken instead
+        if (cursor.index() == line.length() && !line.suggestion().empty())
+        {
+            line.acceptSuggestion();
+            line.update();
+            cursor.moveToEnd();
+            return KeyPressedListener::Status::CONTINUE;
+        }
         cursor.moveRight();
         return KeyPressedListener::Status::CONTINUE;
     });
@@ -225,7 +543,7 @@ void Terminal::registerDefaultKeyListeners()
         auto history = terminal.history();
         if (!history->isManipulated())
         {
-            history->setTopLine(line.content());
+            history->setTopLine(std::string(line.content()));
         }
         auto content = history->next();
         line.setContent(content);
@@ -258,36 +576,48 @@ void Terminal::registerDefaultKeyListeners()
     onKeyPressed(Key::Ctrl('c'), exit_listener_handler);
     onKeyPressed(Key::Ctrl('d'), exit_listener_handler);
     addKeyPressedListener(Key::Tab, completion_);
+    onKeyPressed(Key::Any, [](const Key &key, Line &, Cursor &, Terminal &terminal) {
+        if (key != Key::Tab)
+        {
+            terminal.completion()->closeMenu(terminal);
+        }
+        return KeyPressedListener::Status::OK;
+    });
+
+    // an open menu is opened again below the line for the new size, then the line is drawn again once
+    addKeyPressedListener(Key::Resize, completion_);
+    onKeyPressed(Key::Resize, [](const Key &, Line &line, Cursor &, Terminal &terminal) {
+        line.setViewport(terminal.horizontal_scroll_ ? terminal.getSize().cols : 0);
+        line.invalidate();
+        return KeyPressedListener::Status::CONTINUE;
+    });
 }
 
 void Terminal::registerDefaultLineEnteredListeners()
 {
-    onLineEntered([](const std::string &content, Terminal &terminal) {
-        if (content == "exit" || content == "quit")
-        {
-            terminal.writeText("bye!\n");
-            return LineEnteredListener::Status::BREAK;
-        }
-
-        if (content == "history")
+    auto exit_handler = [](const CommandTree::Invocation &, Terminal &terminal) {
+        terminal.writeText("bye!\n");
+        return LineEnteredListener::Status::BREAK;
+    };
+    // built in, they are not offered by the completion of the application
+    commands_->command("exit").hide().handle(exit_handler);
+    commands_->command("quit").hide().handle(exit_handler);
+    commands_->command("history").hide().handle([](const CommandTree::Invocation &, Terminal &terminal) {
+        std::uint32_t i = 0;
+        for (auto &line : terminal.history()->lines())
         {
-            std::uint32_t i = 0;
-            for (auto &line : terminal.history()->lines())
+            if (i == 0)
             {
-                if (i == 0)
-                {
-                    i++;
-                    continue;
-                }
-                terminal.writeText(string::format("[{}] {}\n", i++, line));
+                i++;
+                continue;
             }
-            return LineEnteredListener::Status::CONTINUE;
+            terminal.writeText(string::format("[{}] {}\n", i++, line));
         }
-
-        return LineEnteredListener::Status::OK;
+        return LineEnteredListener::Status::CONTINUE;
     });
 
-    completion_->insert({"exit", "history"});
+    // the commands come first, lines that are not one go on to the listeners added later
+    addLineEnteredListener(commands_);
 }
 
 KeyPressedListener::Status Terminal::handleKeyPressed(const Key &key, Line &line, Cursor &cursor)
@@ -346,3 +676,344 @@ LineEnteredListener::Status Terminal::handleLineEntered(const std::string &conte
     return LineEnteredListener::Status::OK;
 }
 
+void Terminal::startInput()
+{
+    // coroutines share the reactor of the executor they run on
+    if (!reactor_ && Executor::current() != nullptr)
+    {
+        reactor_ = Executor::current()->reactor();
+    }
+
+    raw_mode_ = std::make_unique<RawMode>(*io_);
+    running_ = true;
+    stop_requested_ = false;
+    auto_prompt_ = false;
+
+    int fd = io_->inputDescriptor();
+    if (fd >= 0)
+    {
+        reactor()->add(fd, EPOLLIN, [this](std::uint32_t) {
+            auto data = io_->readAvailable();
+            if (!data)
+            {
+                feed(std::string(1, Key::Ctrl('d').code()));
+                stop();
+                return;
+            }
+            feed(*data);
+        });
+    }
+
+    int wake_fd = io_->wakeUpDescriptor();
+    if (wake_fd >= 0)
+    {
+        reactor()->add(wake_fd, EPOLLIN, [this](std::uint32_t) {
+            io_->checkWakeUp();
+            Frame frame(*io_);
+            if (line_)
+            {
+                processFedKey(Key::WakeUp);
+                return;
+            }
+            drainPostedText();
+        });
+    }
+
+    int resize_fd = io_->resizeDescriptor();
+    if (resize_fd >= 0 && !reactor()->contains(resize_fd))
+    {
+        reactor()->add(resize_fd, EPOLLIN, [this](std::uint32_t) {
+            if (io_->checkResize() && line_)
+            {
+                Frame frame(*io_);
+                processFedKey(Key::Resize);
+            }
+        });
+    }
+}
+
+void Terminal::stopInput()
+{
+    running_ = false;
+    stop_requested_ = false;
+    cancelEscTimer();
+    if (reactor_ && reactor_->contains(io_->inputDescriptor()))
+    {
+        reactor_->remove(io_->inputDescriptor());
+    }
+    if (reactor_ && reactor_->contains(io_->wakeUpDescriptor()))
+    {
+        reactor_->remove(io_->wakeUpDescriptor());
+    }
+    if (reactor_ && reactor_->contains(io_->resizeDescriptor()))
+    {
+        reactor_->remove(io_->resizeDescriptor());
+    }
+    raw_mode_.reset();
+}
+
+// Wakes up coroutines still waiting when the input is gone
+void Terminal::resumeWaiters()
+{
+    auto *executor = Executor::current();
+    if (executor == nullptr)
+    {
+        return;
+    }
+    if (line_waiter_ != nullptr)
+    {
+        executor->schedule(std::exchange(line_waiter_, nullptr)->handle_);
+    }
+    if (key_waiter_ != nullptr)
+    {
+        key_waiter_->key_ = Key::Ctrl('d');
+        executor->schedule(std::exchange(key_waiter_, nullptr)->handle_);
+    }
+}
+
+void Terminal::beginLine(const std::string &prompt)
+{
+    Frame frame(*io_);
+    drainPostedText();
+    *io_ << "\033[?2004h";
+    line_ = std::make_unique<Line>(prompt, prompt_style_, line_style_, io_);
+    if (horizontal_scroll_)
+    {
+        line_->setViewport(getSize().cols);
+    }
+    if (highlighter_)
+    {
+        line_->setHighlighter(highlighter_);
+    }
+    cursor_ = std::make_unique<Cursor>(*line_, io_);
+    content_.clear();
+    revision_ = 0;
+    utf8_pending_.clear();
+}
+
+bool Terminal::processKey(const Key &key)
+{
+    drainPostedText();
+    if (key != Key::WakeUp && editLine(key))
+    {
+        return true;
+    }
+    if (cursor_)
+    {
+        suggest();
+        cursor_->sync();
+    }
+    return false;
+}
+
+// The history index finds the suggestion walking just the typed text, so it is looked up on every key
+void Terminal::suggest()
+{
+    if (!autosuggest_ || batch_)
+    {
+        return;
+    }
+    // the content is taken only with the cursor at its end, where the gap of the buffer is already:
+    // taking it elsewhere would move the gap away from the cursor on every key
+    std::string_view suggestion;
+    if (cursor_->index() == line_->length() && !history_->isManipulated())
+    {
+        auto content = line_->content();
+        if (!content.empty())
+        {
+            suggestion = history_->suggest(content);
+            suggestion.remove_prefix(std::min(content.size(), suggestion.size()));
+        }
+    }
+    line_->setSuggestion(suggestion);
+    line_->update();
+}
+
+// Posted text goes out in one write: the line is cleared first and drawn again once by the caller
+void Terminal::drainPostedText()
+{
+    wake_pending_.store(false);
+    std::string text;
+    while (auto message = posted_.pop())
+    {
+        text += *message;
+    }
+    if (text.empty())
+    {
+        return;
+    }
+
+    Frame frame(*io_);
+    completion_->closeMenu(*this);
+    if (line_)
+    {
+        *io_ << "\r\033[K";
+        line_->invalidate();
+    }
+    *io_ << text;
+}
+
+bool Terminal::editLine(const Key &key)
+{
+    Line &line = *line_;
+    Cursor &cursor = *cursor_;
+
+    auto key_status = handleKeyPressed(key, line, cursor);
+    if (key_status == KeyPressedListener::Status::CONTINUE) { return false; }
+    if (key_status == KeyPressedListener::Status::BREAK) { return true; }
+
+    if (key.isPaste())
+    {
+        cursor.putText(sanitizePaste(key.text()));
+        if (history_->isManipulated())
+        {
+            history_->rewind();
+        }
+    }
+    else if (key.isPrintable())
+    {
+        cursor.putChar(key.code());
+        if (history_->isManipulated())
+        {
+            history_->rewind();
+        }
+    }
+    else if (!key.isSpecial() && static_cast<unsigned char>(key.code()) >= 0x80)
+    {
+        // a UTF-8 character arrives one byte at a time, it goes into the line once complete
+        auto byte = static_cast<unsigned char>(key.code());
+        if (utf8::sequenceLength(byte) > 1)
+        {
+            utf8_pending_.assign(1, key.code());
+        }
+        else if (!utf8_pending_.empty() && (byte & 0xC0) == 0x80)
+        {
+            utf8_pending_.push_back(key.code());
+        }
+        else
+        {
+            utf8_pending_.clear();
+        }
+        if (!utf8_pending_.empty() &&
+            utf8_pending_.size() == utf8::sequenceLength(static_cast<unsigned char>(utf8_pending_[0])))
+        {
+            cursor.putText(std::exchange(utf8_pending_, std::string()));
+            if (history_->isManipulated())
+            {
+                history_->rewind();
+            }
+        }
+    }
+
+    // comparing revisions spares copying a long line on every key when nobody listens for changes
+    if (revision_ == line.revision() || line_changed_listeners_.empty()) { return false; }
+    revision_ = line.revision();
+    if (content_ == line.content()) { return false; }
+
+    content_ = line.content();
+    auto line_status = handleLineChanged(content_, line, cursor);
+    return line_status == LineChangedListener::Status::BREAK;
+}
+
+void Terminal::processFedInput(bool flush_pending)
+{
+    Frame frame(*io_);
+    processing_ = true;
+    try
+    {
+        // without a line being edited or a coroutine waiting for a key, input stays in the decoder
+        while (running_ && !stop_requested_ && (line_ || key_waiter_))
+        {
+            auto key = flush_pending && decoder_.pending() ? decoder_.flush() : decoder_.next();
+            if (!key)
+            {
+                break;
+            }
+            if (key_waiter_ != nullptr)
+            {
+                key_waiter_->key_ = *key;
+                currentExecutor().schedule(std::exchange(key_waiter_, nullptr)->handle_);
+                continue;
+            }
+            processFedKey(*key);
+        }
+    }
+    catch (...)
+    {
+        processing_ = false;
+        throw;
+    }
+    processing_ = false;
+
+    // a lonely <ESC> is a key on its own once the timeout passes, also for whoever polls the
+    // reactor without going through pollOnce()
+    cancelEscTimer();
+    if (running_ && decoder_.pending())
+    {
+        esc_deadline_ = std::chrono::steady_clock::now() + esc_timeout_;
+        esc_timer_ = reactor()->addTimer(esc_timeout_, std::chrono::milliseconds(0), [this]() {
+            cancelEscTimer();
+            if (running_ && decoder_.pending())
+            {
+                processFedInput(true);
+            }
+        });
+    }
+    if (stop_requested_)
+    {
+        stop();
+    }
+}
+
+void Terminal::cancelEscTimer()
+{
+    if (esc_timer_ >= 0)
+    {
+        reactor()->removeTimer(std::exchange(esc_timer_, -1));
+    }
+}
+
+void Terminal::processFedKey(const Key &key)
+{
+    if (!line_ || !processKey(key))
+    {
+        return;
+    }
+
+    auto content = endLine();
+    if (line_waiter_ != nullptr)
+    {
+        line_waiter_->line_ = content;
+        currentExecutor().schedule(std::exchange(line_waiter_, nullptr)->handle_);
+        return;
+    }
+
+    content = string::trim(content);
+    auto status = handleLineEntered(content);
+    if (status == LineEnteredListener::Status::BREAK)
+    {
+        stop_requested_ = true;
+        return;
+    }
+    if (running_ && !stop_requested_ && auto_prompt_)
+    {
+        beginLine(prompt_);
+    }
+}
+
+std::string Terminal::endLine()
+{
+    std::string content(line_->content());
+    abortLine();
+    history_->insert(content);
+    history_->rewind();
+    return content;
+}
+
+void Terminal::abortLine()
+{
+    cursor_.reset();
+    line_.reset();
+    *io_ << "\033[?2004l";
+}
+
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <deque>
+#include <gtest/gtest.h>
+#include "cmdly/command.h"
+#include "cmdly/terminal.h"
+#include "helpers/io_mock.h"
+
+using namespace cmdly;
+
+class CommandIOMock : public OutputIOMock
+{
+public:
+    std::deque<Key> keys;
+
+    Key getKey() override
+    {
+        Key k = keys.front();
+        keys.pop_front();
+        return k;
+    }
+
+    void getWindowSize(std::size_t *cols, std::size_t *rows) const override
+    {
+        *cols = 80;
+        *rows = 24;
+    }
+};
+
+static void addBucketCommands(CommandTree &commands, std::vector<std::string> &calls)
+{
+    auto &bucket = commands.command("bucket");
+    bucket.command("create")
+        .argument("name")
+        .argument("size", CommandTree::Argument::Type::Integer, true)
+        .handle([&calls](const CommandTree::Invocation &call, Terminal &) {
+            std::string called = "create " + call.get("name");
+            if (call.has("size"))
+            {
+                called += ' ';
+                called += std::to_string(call.integer("size"));
+            }
+            calls.push_back(called);
+            return LineEnteredListener::Status::CONTINUE;
+        });
+    bucket.command("delete")
+        .argument("name")
+        .complete([](std::string_view) { return std::vector<std::string>{"logs", "photos", "backups"}; })
+        .handle([&calls](const CommandTree::Invocation &call, Terminal &) {
+            calls.push_back("delete " + call.get("name"));
+            return LineEnteredListener::Status::CONTINUE;
+        });
+    bucket.command("region")
+        .choice("region", {"eu-west", "eu-north", "us-east"})
+        .handle([&calls](const CommandTree::Invocation &call, Terminal &) {
+            calls.push_back("region " + call.get("region"));
+            return LineEnteredListener::Status::CONTINUE;
+        });
+}
+
+TEST(CommandTest, checkLineIsSplitIntoTokens)
+{
+    auto tokens = CommandTree::tokenize("  bucket create \"my logs\" 10");
+    ASSERT_EQ(tokens.size(), 4);
+    EXPECT_EQ(tokens[0].text, "bucket");
+    EXPECT_EQ(tokens[0].begin, 2);
+    EXPECT_EQ(tokens[2].text, "my logs");
+    EXPECT_EQ(tokens[2].begin, 16);
+    EXPECT_EQ(tokens[2].end, 25);
+    EXPECT_EQ(tokens[3].text, "10");
+}
+
+TEST(CommandTest, checkLineGoesToHandlerOfCommand)
+{
+    auto io = std::make_shared<CommandIOMock>();
+    Terminal terminal(io);
+    std::vector<std::string> calls;
+    CommandTree commands;
+    addBucketCommands(commands, calls);
+
+    EXPECT_EQ(commands.invoke("bucket create logs", terminal), LineEnteredListener::Status::CONTINUE);
+    commands.invoke("bucket create \"old logs\" 42", terminal);
+    commands.invoke("bucket region eu-north", terminal);
+    EXPECT_EQ(calls, (std::vector<std::string>{"create logs", "create old logs 42", "region eu-north"}));
+
+    // lines that are not a command are left to other listeners
+    EXPECT_EQ(commands.invoke("create logs", terminal), LineEnteredListener::Status::OK);
+    EXPECT_EQ(commands.invoke("", terminal), LineEnteredListener::Status::OK);
+}
+
+TEST(CommandTest, checkWrongArgumentsGetUsage)
+{
+    auto io = std::make_shared<CommandIOMock>();
+    Terminal terminal(io);
+    std::vector<std::string> calls;
+    CommandTree commands;
+    addBucketCommands(commands, calls);
+
+    io->output.clear();
+    EXPECT_EQ(commands.invoke("bucket create logs big", terminal), LineEnteredListener::Status::CONTINUE);
+    EXPECT_NE(io->output.find("bucket create: invalid <size>: big"), std::string::npos);
+    EXPECT_NE(io->output.find("usage: bucket create <name> [<size>]"), std::string::npos);
+
+    io->output.clear();
+    commands.invoke("bucket region mars", terminal);
+    EXPECT_NE(io->output.find("usage: bucket region <region>"), std::string::npos);
+    io->output.clear();
+    commands.invoke("bucket create", terminal);
+    EXPECT_NE(io->output.find("usage: bucket create <name> [<size>]"), std::string::npos);
+    io->output.clear();
+    commands.invoke("bucket", terminal);
+    EXPECT_NE(io->output.find("usage: bucket {create|delete|region}"), std::string::npos);
+    EXPECT_TRUE(calls.empty());
+}
+
+TEST(CommandTest, checkNextWordIsCompletedByContext)
+{
+    std::vector<std::string> calls;
+    CommandTree commands;
+    addBucketCommands(commands, calls);
+
+    std::vector<std::string> candidates;
+    EXPECT_TRUE(commands.complete({"bucket"}, "", candidates));
+    EXPECT_EQ(candidates, (std::vector<std::string>{"create", "delete", "region"}));
+    EXPECT_TRUE(commands.complete({"bucket", "region"}, "eu", candidates));
+    EXPECT_EQ(candidates, (std::vector<std::string>{"eu-north", "eu-west"}));
+    EXPECT_TRUE(commands.complete({"bucket", "delete"}, "", candidates));
+    EXPECT_EQ(candidates, (std::vector<std::string>{"backups", "logs", "photos"}));
+
+    // nothing comes after the last argument, unknown commands are not completed
+    EXPECT_TRUE(commands.complete({"bucket", "region", "eu-west"}, "", candidates));
+    EXPECT_TRUE(candidates.empty());
+    EXPECT_FALSE(commands.complete({"object"}, "", candidates));
+}
+
+TEST(CommandTest, checkTabCompletesWordUnderCursor)
+{
+    auto io = std::make_shared<CommandIOMock>();
+    Terminal terminal(io);
+    std::vector<std::string> calls;
+    addBucketCommands(*terminal.commands(), calls);
+
+    // the command name, then its subcommand and a value of its argument
+    io->keys = {Key('b'), Key::Tab, Key('r'), Key::Tab, Key('e'), Key('u'), Key('-'), Key('n'), Key::Tab, Key::Enter};
+    EXPECT_EQ(terminal.readLine("> "), "bucket region eu-north ");
+
+    // only the word under the cursor changes, what follows it stays
+    io->keys = {Key('b'), Key('u'), Key('c'), Key('k'), Key('e'), Key('t'), Key(' '), Key('d'), Key('e'), Key(' '), Key('x'),
+                Key::ArrowLeft, Key::ArrowLeft, Key::Tab, Key::Enter};
+    EXPECT_EQ(terminal.readLine("> "), "bucket delete  x");
+}
+
+TEST(CommandTest, checkDispatchLooksUpOneCommandPerWord)
+{
+    auto io = std::make_shared<CommandIOMock>();
+    Terminal terminal(io);
+    CommandTree commands;
+    std::size_t called = 0;
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+        commands.command("service-" + std::to_string(i)).command("restart").handle([&called, i](const auto &call, Terminal &) {
+            called = i;
+            EXPECT_EQ(call.path(), (std::vector<std::string>{"service-" + std::to_string(i), "restart"}));
+            return LineEnteredListener::Status::CONTINUE;
+        });
+    }
+    commands.invoke("service-9999 restart", terminal);
+    EXPECT_EQ(called, 9999);
+    commands.invoke("service-42 restart", terminal);
+    EXPECT_EQ(called, 42);
+}
+
+TEST(CommandTest, checkWordsAfterCommandWithoutArgumentsGoToListeners)
+{
+    auto io = std::make_shared<CommandIOMock>();
+    Terminal terminal(io);
+    std::vector<std::string> lines;
+    terminal.onLineEntered([&lines](const std::string &line, Terminal &) {
+        lines.push_back(line);
+        return LineEnteredListener::Status::OK;
+    });
+
+    // "history" and "exit" are built in, yet a line only starting with them is someone else's
+    io->output.clear();
+    EXPECT_EQ(terminal.commands()->invoke("history clear", terminal), LineEnteredListener::Status::OK);
+    EXPECT_EQ(terminal.commands()->invoke("exit now", terminal), LineEnteredListener::Status::OK);
+    EXPECT_EQ(io->output.find("usage:"), std::string::npos);
+    EXPECT_EQ(io->output.find("bye!"), std::string::npos);
+
+    terminal.start("> ");
+    terminal.feed("history clear\r");
+    terminal.feed("quit later\r");
+    EXPECT_EQ(lines, (std::vector<std::string>{"history clear", "quit later"}));
+    EXPECT_TRUE(terminal.isRunning());
+}
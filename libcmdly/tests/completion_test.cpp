@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <deque>
+#include <gtest/gtest.h>
+#include "cmdly/terminal.h"
+#include "helpers/io_mock.h"
+
+using namespace cmdly;
+
+class MenuIOMock : public IOMock
+{
+public:
+    std::deque<Key> keys;
+    mutable std::vector<std::string> writes;
+
+    Key getKey() override
+    {
+        Key k = keys.front();
+        keys.pop_front();
+        return k;
+    }
+
+    void write(const std::string &data) const override
+    {
+        writes.push_back(data);
+    }
+
+    void getWindowSize(std::size_t *cols, std::size_t *rows) const override
+    {
+        *cols = 40;
+        *rows = 24;
+    }
+};
+
+static std::shared_ptr<Completion> completionOf(std::initializer_list<std::string> words)
+{
+    auto completion = std::make_shared<Completion>();
+    completion->insert(words);
+    return completion;
+}
+
+TEST(CompletionTest, checkIndexFindsWordsOfPhraseInOrder)
+{
+    CompletionIndex index;
+    for (auto word : {"help", "hello", "exit", "helium", "he", "history"})
+    {
+        EXPECT_TRUE(index.insert(word));
+    }
+    EXPECT_FALSE(index.insert("hello"));
+    EXPECT_EQ(index.size(), 6);
+
+    std::string prefix;
+    auto node = index.find("hel", prefix);
+    ASSERT_NE(node, CompletionIndex::NONE);
+    EXPECT_EQ(prefix, "hel");
+    std::vector<std::string> words;
+    index.visit(node, prefix, [&words](const std::string &word) { words.push_back(word); });
+    EXPECT_EQ(words, (std::vector<std::string>{"helium", "hello", "help"}));
+
+    // a phrase ending inside an edge gets the whole edge as the common prefix
+    node = index.find("hi", prefix);
+    ASSERT_NE(node, CompletionIndex::NONE);
+    EXPECT_EQ(prefix, "history");
+    EXPECT_EQ(index.find("hx", prefix), CompletionIndex::NONE);
+    EXPECT_EQ(index.find("helpers", prefix), CompletionIndex::NONE);
+}
+
+TEST(CompletionTest, checkSearchGivesLongestCommonPrefix)
+{
+    Completion completion;
+    completion.insert({"config-get", "config-set", "connect", "été", "écho"});
+
+    auto result = completion.search("conf");
+    EXPECT_EQ(result->words, (std::vector<std::string>{"config-get", "config-set"}));
+    EXPECT_EQ(result->longest_common_prefix, "config-");
+    EXPECT_EQ(result->smallest_word_length, 10);
+    EXPECT_EQ(result->longest_word_length, 10);
+
+    // words ordered the way std::string compares them, bytes above 0x7f last
+    EXPECT_EQ(completion.search("")->words.back(), "été");
+    EXPECT_EQ(completion.search("\xc3")->longest_common_prefix, "é");
+    EXPECT_TRUE(completion.search("connect")->longest_common_prefix.empty());
+    EXPECT_TRUE(completion.search("d")->empty());
+}
+
+TEST(CompletionTest, checkMenuSelectionIsTakenWithEnter)
+{
+    auto io = std::make_shared<MenuIOMock>();
+    io->keys = {Key('h'), Key('e'), Key::Tab, Key::Tab, Key::Tab, Key::Enter, Key::Enter};
+    auto completion = completionOf({"help", "hello", "helium", "exit"});
+    Terminal terminal(io, std::make_shared<MemoryHistory>(), completion);
+
+    EXPECT_EQ(terminal.readLine("> "), "hello ");
+    EXPECT_FALSE(completion->isMenuOpen());
+}
+
+TEST(CompletionTest, checkMovingSelectionRepaintsTwoCandidates)
+{
+    auto io = std::make_shared<MenuIOMock>();
+    io->keys = {Key('h'), Key('e'), Key::Tab, Key::Tab, Key::ArrowRight, Key('x'), Key::Enter};
+    auto completion = completionOf({"help", "hello", "helium", "exit"});
+    Terminal terminal(io, std::make_shared<MemoryHistory>(), completion);
+    EXPECT_EQ(terminal.readLine("> "), "helx");
+
+    // prompt, then one write per key
+    ASSERT_EQ(io->writes.size(), 9);
+    auto opened = io->writes[3];
+    EXPECT_NE(opened.find("helium"), std::string::npos);
+    EXPECT_NE(opened.find("hello"), std::string::npos);
+    EXPECT_NE(opened.find("help"), std::string::npos);
+
+    // the first selection paints one candidate, a move paints the old and the new one only
+    auto inverted = TextStyle(Color::Default, Color::Default, FontStyle::Invert).str();
+    EXPECT_NE(io->writes[4].find(inverted + "helium"), std::string::npos);
+    EXPECT_EQ(io->writes[4].find("hello"), std::string::npos);
+    auto moved = io->writes[5];
+    EXPECT_NE(moved.find("helium"), std::string::npos);
+    EXPECT_NE(moved.find(inverted + "hello"), std::string::npos);
+    EXPECT_EQ(moved.find("help"), std::string::npos);
+    EXPECT_LT(moved.size(), 48);
+
+    // typing closes the menu, its row is erased rather than drawn again
+    auto closed = io->writes[6];
+    EXPECT_NE(closed.find("\033[K"), std::string::npos);
+    EXPECT_EQ(closed.find("hel"), std::string::npos);
+}
+
+TEST(CompletionTest, checkBuiltInCommandsAreNotCompleted)
+{
+    auto io = std::make_shared<MenuIOMock>();
+    auto completion = completionOf({"hello", "help"});
+    Terminal terminal(io, std::make_shared<MemoryHistory>(), completion);
+
+    // "history" is built in, the words of the application alone are completed
+    io->keys = {Key('h'), Key::Tab, Key::Enter};
+    EXPECT_EQ(terminal.readLine("> "), "hel");
+    io->keys = {Key('h'), Key::Tab, Key::Enter};
+    EXPECT_EQ(terminal.readLine("> "), "hel");
+    EXPECT_FALSE(completion->isMenuOpen());
+
+    // commands declared by the application join the words
+    terminal.commands()->command("hex").handle([](const CommandTree::Invocation &, Terminal &) {
+        return LineEnteredListener::Status::CONTINUE;
+    });
+    io->keys = {Key('h'), Key('e'), Key('x'), Key::Tab, Key::Enter};
+    EXPECT_EQ(terminal.readLine("> "), "hex ");
+    io->keys = {Key('h'), Key::Tab, Key::Enter};
+    EXPECT_EQ(terminal.readLine("> "), "he");
+}
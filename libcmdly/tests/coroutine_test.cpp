@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/coroutine.h"
+#include "cmdly/terminal.h"
+#include "helpers/io_mock.h"
+
+using namespace cmdly;
+
+class CoroutineIOMock : public IOMock
+{
+public:
+    std::string position = "\033[1;1R";
+    std::size_t position_index = 0;
+
+    char getChar() override
+    {
+        char c = position[position_index];
+        position_index = (position_index + 1) % position.size();
+        return c;
+    }
+};
+
+static Task<int> answer()
+{
+    co_return 42;
+}
+
+static Task<int> doubledAnswer()
+{
+    int value = co_await answer();
+    co_return value * 2;
+}
+
+TEST(CoroutineTest, checkNestedTasksReturnValues)
+{
+    Executor executor;
+    int result = 0;
+    // the closure has to outlive the coroutine, which reads its captures through it
+    auto body = [&result]() -> Task<> {
+        result = co_await doubledAnswer();
+    };
+    executor.spawn(body());
+    executor.run();
+    EXPECT_EQ(result, 84);
+}
+
+TEST(CoroutineTest, checkTaskExceptionIsRethrownByExecutor)
+{
+    Executor executor;
+    auto body = []() -> Task<> {
+        co_await answer();
+        throw CmdlyError("task failed");
+    };
+    executor.spawn(body());
+    EXPECT_THROW(executor.run(), CmdlyError);
+}
+
+TEST(CoroutineTest, checkSleepResumesTask)
+{
+    Executor executor;
+    std::vector<int> order;
+    auto sleeping = [&]() -> Task<> {
+        co_await executor.sleep(std::chrono::milliseconds(5));
+        order.push_back(2);
+    };
+    executor.spawn(sleeping());
+    auto body = [&]() -> Task<> {
+        order.push_back(1);
+        co_return;
+    };
+    executor.spawn(body());
+    executor.run();
+    EXPECT_EQ(order, std::vector<int>({1, 2}));
+}
+
+TEST(CoroutineTest, checkReadLineAsyncReturnsFedLines)
+{
+    auto io = std::make_shared<CoroutineIOMock>();
+    EXPECT_CALL(*io, write(::testing::_)).Times(::testing::AnyNumber());
+    Terminal terminal(io);
+    Executor executor;
+    std::vector<std::string> lines;
+
+    auto body = [&]() -> Task<> {
+        for (;;)
+        {
+            auto line = co_await terminal.readLineAsync("async> ");
+            if (line == "exit")
+            {
+                break;
+            }
+            lines.push_back(line);
+        }
+    };
+    executor.spawn(body());
+    // both lines arrive at once, the second one waits until the coroutine asks for it
+    executor.post([&terminal]() {
+        terminal.feed("first\rsec");
+    });
+    executor.post([&terminal]() {
+        terminal.feed("ond\rexit\r");
+    });
+    executor.run();
+
+    EXPECT_EQ(lines, std::vector<std::string>({"first", "second"}));
+}
+
+TEST(CoroutineTest, checkNextKeyAsyncReturnsRawKeys)
+{
+    auto io = std::make_shared<CoroutineIOMock>();
+    EXPECT_CALL(*io, write(::testing::_)).Times(::testing::AnyNumber());
+    Terminal terminal(io);
+    Executor executor;
+    std::vector<Key> keys;
+
+    auto body = [&]() -> Task<> {
+        keys.push_back(co_await terminal.nextKeyAsync());
+        keys.push_back(co_await terminal.nextKeyAsync());
+        auto line = co_await terminal.readLineAsync("> ");
+        EXPECT_EQ(line, "yes");
+        terminal.stop();
+    };
+    executor.spawn(body());
+    executor.post([&terminal]() {
+        terminal.feed("\033[Aqyes\r");
+    });
+    executor.run();
+
+    ASSERT_EQ(keys.size(), 2);
+    EXPECT_EQ(keys[0], Key::ArrowUp);
+    EXPECT_EQ(keys[1], Key('q'));
+}
+
+TEST(CoroutineTest, checkLonelyEscIsDeliveredAfterTimeout)
+{
+    auto io = std::make_shared<CoroutineIOMock>();
+    EXPECT_CALL(*io, write(::testing::_)).Times(::testing::AnyNumber());
+    Terminal terminal(io);
+    terminal.setEscTimeout(std::chrono::milliseconds(10));
+    Executor executor;
+    std::vector<Key> keys;
+
+    // nothing but the reactor of the executor is polled, its timer has to give the key
+    auto body = [&]() -> Task<> {
+        keys.push_back(co_await terminal.nextKeyAsync());
+        terminal.stop();
+    };
+    executor.spawn(body());
+    executor.post([&terminal]() {
+        terminal.feed("\033");
+    });
+    executor.run();
+
+    ASSERT_EQ(keys.size(), 1);
+    EXPECT_EQ(keys[0], Key::Esc);
+}
+
+TEST(CoroutineTest, checkAwaitingWithoutExecutorThrows)
+{
+    auto io = std::make_shared<CoroutineIOMock>();
+    EXPECT_CALL(*io, write(::testing::_)).Times(::testing::AnyNumber());
+    Terminal terminal(io);
+    auto body = [&]() -> Task<std::string> {
+        co_return co_await terminal.readLineAsync("> ");
+    };
+    auto task = body();
+    task.handle().resume();
+    EXPECT_THROW(task.result(), CmdlyError);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <deque>
+#include <gtest/gtest.h>
+#include "cmdly/cursor.h"
+#include "helpers/io_mock.h"
+
+using namespace cmdly;
+
+class CaptureIOMock : public OutputIOMock
+{
+public:
+    std::deque<char> chars;
+    bool answers = true;
+
+    char getChar() override
+    {
+        char c = chars.front();
+        chars.pop_front();
+        return c;
+    }
+
+    bool waitForInput(std::chrono::milliseconds) override
+    {
+        return answers && !chars.empty();
+    }
+};
+
+class CursorTest : public ::testing::Test
+{
+protected:
+    std::shared_ptr<CaptureIOMock> io = std::make_shared<CaptureIOMock>();
+};
+
+TEST_F(CursorTest, checkMovesAreRelativeToTrackedColumn)
+{
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+    cursor.putChar('a');
+    cursor.putChar('b');
+    EXPECT_EQ(line.screenColumn(), 5);
+
+    io->output.clear();
+    cursor.moveLeft();
+    EXPECT_EQ(io->output, "\b");
+    io->output.clear();
+    cursor.moveToHome();
+    EXPECT_EQ(io->output, "\b");
+    io->output.clear();
+    // writing the two characters again is cheaper than ESC[2C
+    cursor.moveToEnd();
+    EXPECT_EQ(io->output, "ab");
+    EXPECT_EQ(cursor.col(), 5);
+}
+
+TEST_F(CursorTest, checkUnknownStateIsRedrawnBeforeMove)
+{
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+    cursor.putChar('a');
+    line.invalidate();
+
+    io->output.clear();
+    cursor.moveLeft();
+    EXPECT_EQ(io->output.front(), '\r');
+    EXPECT_EQ(line.screenColumn(), 3);
+}
+
+TEST_F(CursorTest, checkQueryPositionReadsAnswer)
+{
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+    io->chars = {'\033', '[', '7', ';', '3', 'R'};
+    EXPECT_TRUE(cursor.queryPosition());
+    EXPECT_EQ(cursor.row(), 7);
+    EXPECT_EQ(line.screenColumn(), 3);
+}
+
+TEST_F(CursorTest, checkQueryPositionFallsBackOnTimeout)
+{
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+    io->answers = false;
+    EXPECT_FALSE(cursor.queryPosition(std::chrono::milliseconds(1)));
+    EXPECT_EQ(line.screenColumn(), 0);
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/decoder.h"
+
+using namespace testing;
+using namespace cmdly;
+
+TEST(KeyDecoderTest, checkManyKeysInOneReadAreSplit)
+{
+    KeyDecoder decoder;
+    decoder.feed("ab\033[Dc\r");
+    EXPECT_EQ(decoder.next(), Key('a'));
+    EXPECT_EQ(decoder.next(), Key('b'));
+    EXPECT_EQ(decoder.next(), Key::ArrowLeft);
+    EXPECT_EQ(decoder.next(), Key('c'));
+    EXPECT_EQ(decoder.next(), Key::Enter);
+    EXPECT_FALSE(decoder.next().has_value());
+    EXPECT_TRUE(decoder.empty());
+}
+
+TEST(KeyDecoderTest, checkSequenceSplitAcrossReadsIsJoined)
+{
+    KeyDecoder decoder;
+    decoder.feed("x\033");
+    EXPECT_EQ(decoder.next(), Key('x'));
+    EXPECT_FALSE(decoder.next().has_value());
+    EXPECT_TRUE(decoder.pending());
+    decoder.feed("[1;5");
+    EXPECT_FALSE(decoder.next().has_value());
+    decoder.feed("Cy");
+    EXPECT_EQ(decoder.next(), Key("^[1;5C"));
+    EXPECT_EQ(decoder.next(), Key('y'));
+}
+
+TEST(KeyDecoderTest, checkSs3AndAlternativeSequencesAreNormalized)
+{
+    KeyDecoder decoder;
+    decoder.feed("\033OA\033OP\033[1~\033[4~");
+    EXPECT_EQ(decoder.next(), Key::ArrowUp);
+    EXPECT_EQ(decoder.next(), Key::F1);
+    EXPECT_EQ(decoder.next(), Key::Home);
+    EXPECT_EQ(decoder.next(), Key::End);
+}
+
+TEST(KeyDecoderTest, checkEscAndAltKeys)
+{
+    KeyDecoder decoder;
+    decoder.feed("\033x\033\033");
+    EXPECT_EQ(decoder.next(), Key::Alt('x'));
+    EXPECT_EQ(decoder.next(), Key::Esc);
+    EXPECT_FALSE(decoder.next().has_value());
+    EXPECT_TRUE(decoder.pending());
+    EXPECT_EQ(decoder.flush(), Key::Esc);
+    EXPECT_TRUE(decoder.empty());
+}
+
+TEST(KeyDecoderTest, checkBracketedPasteIsOneKey)
+{
+    KeyDecoder decoder;
+    decoder.feed("a\033[200~pasted \033[A");
+    EXPECT_EQ(decoder.next(), Key('a'));
+    EXPECT_FALSE(decoder.next().has_value());
+    EXPECT_TRUE(decoder.pasting());
+    EXPECT_FALSE(decoder.pending());
+    decoder.feed("text\033[20");
+    EXPECT_FALSE(decoder.next().has_value());
+    decoder.feed("1~b");
+    auto key = decoder.next();
+    ASSERT_TRUE(key.has_value());
+    EXPECT_TRUE(key->isPaste());
+    EXPECT_EQ(key->text(), "pasted \033[Atext");
+    EXPECT_EQ(decoder.next(), Key('b'));
+}
+
+TEST(KeyDecoderTest, checkRawBytesCanBeTaken)
+{
+    KeyDecoder decoder;
+    decoder.feed("\033[12;3R");
+    std::string data;
+    while (auto c = decoder.takeByte())
+    {
+        data.push_back(*c);
+    }
+    EXPECT_EQ(data, "\033[12;3R");
+}
+
+TEST(KeyDecoderTest, checkBulkPasteIsDecodedInLinearTime)
+{
+    const std::size_t size = 1024 * 1024;
+    const std::string chunk(4096, 'a');
+    KeyDecoder decoder;
+    std::size_t keys = 0;
+
+    for (std::size_t fed = 0; fed < size; fed += chunk.size())
+    {
+        decoder.feed(chunk);
+    }
+    while (auto key = decoder.next())
+    {
+        EXPECT_TRUE(key->isPrintable());
+        keys++;
+    }
+
+    EXPECT_EQ(keys, size);
+    EXPECT_EQ(decoder.steps(), size);
+}
+
+TEST(KeyDecoderTest, checkLargeBracketedPasteIsDecodedInLinearTime)
+{
+    const std::size_t size = 4 * 1024 * 1024;
+    const std::string chunk(4096, 'p');
+    KeyDecoder decoder;
+
+    decoder.feed(KeyDecoder::PASTE_BEGIN);
+    for (std::size_t fed = 0; fed < size; fed += chunk.size())
+    {
+        decoder.feed(chunk);
+    }
+    decoder.feed(KeyDecoder::PASTE_END);
+    auto key = decoder.next();
+
+    ASSERT_TRUE(key.has_value());
+    EXPECT_EQ(key->text().size(), size);
+    EXPECT_FALSE(decoder.next().has_value());
+    // the end marker is searched for once and the text copied once
+    EXPECT_LE(decoder.steps(), 2 * size + 2 * KeyDecoder::PASTE_END.size());
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/completion.h"
+#include "cmdly/fuzzy.h"
+
+using namespace cmdly;
+
+static std::vector<std::string> wordsOf(const FuzzyMatcher &matcher, const std::vector<FuzzyMatcher::Match> &matches)
+{
+    std::vector<std::string> words;
+    for (auto &match : matches)
+    {
+        words.push_back(matcher.word(match.index));
+    }
+    return words;
+}
+
+TEST(FuzzyTest, checkCharactersMatchInOrderOnly)
+{
+    EXPECT_NE(FuzzyMatcher::score("storage/bucket/list", "sbl", true), FuzzyMatcher::NO_MATCH);
+    EXPECT_EQ(FuzzyMatcher::score("storage/bucket/list", "lbs", true), FuzzyMatcher::NO_MATCH);
+    EXPECT_EQ(FuzzyMatcher::score("storage", "storages", true), FuzzyMatcher::NO_MATCH);
+
+    // a lower case query ignores case, one with a capital does not
+    EXPECT_NE(FuzzyMatcher::score("getBucketList", "gbl", true), FuzzyMatcher::NO_MATCH);
+    EXPECT_EQ(FuzzyMatcher::score("getbucketlist", "gBl", false), FuzzyMatcher::NO_MATCH);
+}
+
+TEST(FuzzyTest, checkWordBoundariesScoreHigher)
+{
+    // starts of words beat the same characters in the middle of them
+    EXPECT_GT(FuzzyMatcher::score("storage/bucket/list", "sbl", true),
+              FuzzyMatcher::score("subtle", "sbl", true));
+    EXPECT_GT(FuzzyMatcher::score("getBucketList", "gbl", true),
+              FuzzyMatcher::score("gobbling", "gbl", true));
+    // and a run of characters beats them spread out
+    EXPECT_GT(FuzzyMatcher::score("bucket", "buck", true),
+              FuzzyMatcher::score("b-u-c-k", "buck", true));
+}
+
+TEST(FuzzyTest, checkBestMatchesComeFirst)
+{
+    FuzzyMatcher matcher;
+    for (auto word : {"subtle", "storage/bucket/list", "storage/bucket/lock", "sable", "server/bus/log"})
+    {
+        matcher.insert(word);
+    }
+    // the gaps count too, words scoring the same are in order
+    auto words = wordsOf(matcher, matcher.search("sbl", 4));
+    EXPECT_EQ(words, (std::vector<std::string>{"server/bus/log", "sable", "storage/bucket/list", "storage/bucket/lock"}));
+    EXPECT_TRUE(matcher.search("xyz", 3).empty());
+}
+
+TEST(FuzzyTest, checkThreadsFindTheSameMatches)
+{
+    FuzzyMatcher matcher;
+    for (std::size_t i = 0; i < 4 * FuzzyMatcher::PARALLEL_THRESHOLD; ++i)
+    {
+        matcher.insert("region-" + std::to_string(i % 7) + "/volume-" + std::to_string(i));
+    }
+    auto serial = wordsOf(matcher, matcher.search("r3v99", 20, 1));
+    auto parallel = wordsOf(matcher, matcher.search("r3v99", 20, 4));
+    ASSERT_EQ(serial.size(), 20);
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST(FuzzyTest, checkCompletionRanksFuzzyMatches)
+{
+    Completion completion;
+    completion.insert({"storage/bucket/list", "storage/bucket/create", "system/status"});
+    EXPECT_TRUE(completion.search("sbl")->empty());
+
+    completion.setMatching(Completion::Matching::Fuzzy);
+    completion.insert("sable");
+    auto result = completion.search("sbl");
+    EXPECT_EQ(result->words, (std::vector<std::string>{"sable", "storage/bucket/list"}));
+    EXPECT_TRUE(result->longest_common_prefix.empty());
+
+    // an empty phrase still lists every word
+    EXPECT_EQ(completion.search("")->size(), 4);
+    completion.setFuzzyLimit(1);
+    EXPECT_EQ(completion.search("s")->size(), 1);
+}
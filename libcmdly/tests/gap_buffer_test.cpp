@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/gap_buffer.h"
+
+using namespace cmdly;
+
+TEST(GapBufferTest, checkEditsAnywhere)
+{
+    GapBuffer buffer("simple");
+    buffer.insert(0, "$");
+    buffer.insert(4, "$");
+    buffer.insert(8, "$");
+    EXPECT_EQ(buffer.str(), "$sim$ple$");
+    EXPECT_EQ(buffer.size(), 9);
+    EXPECT_EQ(buffer[4], '$');
+    EXPECT_EQ(buffer[5], 'p');
+
+    buffer.erase(4, 1);
+    buffer.erase(0, 1);
+    buffer.erase(6, 10);
+    EXPECT_EQ(buffer.str(), "simple");
+
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(GapBufferTest, checkGrowsPastTheGap)
+{
+    GapBuffer buffer;
+    std::string expected;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto index = std::size_t(i) % (expected.size() + 1);
+        buffer.insert(index, "ab");
+        expected.insert(index, "ab");
+    }
+    EXPECT_EQ(buffer.str(), expected);
+}
+
+TEST(GapBufferTest, checkViewsAndPieces)
+{
+    GapBuffer buffer("hello world");
+    buffer.insert(5, ",");
+    auto [before, after] = buffer.pieces();
+    EXPECT_EQ(before, "hello,");
+    EXPECT_EQ(after, " world");
+    EXPECT_EQ(buffer.pieces(8).first, "");
+    EXPECT_EQ(buffer.pieces(8).second, "orld");
+
+    // a view across the gap moves it away without changing the text
+    EXPECT_EQ(buffer.view(3, 9), "lo, wo");
+    EXPECT_EQ(buffer.view(), "hello, world");
+    EXPECT_EQ(buffer.str(), "hello, world");
+}
+
+TEST(GapBufferTest, checkMismatch)
+{
+    GapBuffer buffer("abcdef");
+    buffer.insert(3, "X");
+    EXPECT_EQ(buffer.mismatch("abcdef"), 3);
+    EXPECT_EQ(buffer.mismatch("abcXdef"), 7);
+    EXPECT_EQ(buffer.mismatch("abcXd"), 5);
+    EXPECT_EQ(buffer.mismatch("abcXdeZ", 4), 6);
+}
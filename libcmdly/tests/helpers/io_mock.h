@@ -18,4 +18,11 @@ public:
     ~IOMock() override { die(); }
 }; /* End of class IOMock */
 
+// Keeps everything written, for tests checking the bytes sent to the terminal
+class OutputIOMock : public IOMock {
+public:
+    mutable std::string output;
+    void write(const std::string &data) const override { output += data; }
+}; /* End of class OutputIOMock */
+
 #endif /* !CMDLY_TESTS_HELPERS_IO_MOCK_H */
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/cursor.h"
+#include "cmdly/highlight.h"
+#include "cmdly/line.h"
+#include "helpers/io_mock.h"
+
+using namespace testing;
+using namespace cmdly;
+
+// Words and the spaces between them are tokens, "if" is a keyword and everything after '#' is a
+// comment, which the state carries to the next token
+class WordHighlighter : public Highlighter
+{
+public:
+    enum : State { CODE, COMMENT };
+
+    std::uint32_t keyword = addStyle(TextStyle(Color::Blue));
+    std::uint32_t comment = addStyle(TextStyle(Color::Green));
+    std::size_t lexed = 0;
+
+    Token next(std::string_view text, State state) override
+    {
+        lexed++;
+        bool space = text[0] == ' ';
+        auto length = std::min(text.size(), space ? text.find_first_not_of(' ') : text.find(' '));
+        auto word = text.substr(0, length);
+        if (state == COMMENT || word[0] == '#')
+        {
+            return {length, comment, COMMENT};
+        }
+        return {length, word == "if" ? keyword : CONTENT_STYLE, CODE};
+    }
+}; /* End of class WordHighlighter */
+
+static std::vector<std::string> styledWords(Line &line, const std::shared_ptr<Highlighter> &highlighter)
+{
+    // words written in a style other than the content one, as drawn
+    auto io = std::make_shared<OutputIOMock>();
+    Line copy("", TextStyle(), TextStyle(), io);
+    copy.setHighlighter(highlighter);
+    copy.setContent(line.content());
+    copy.redraw();
+    std::vector<std::string> words;
+    for (std::uint32_t index : {1u, 2u})
+    {
+        auto style = highlighter->style(index)->str();
+        for (auto pos = io->output.find(style); pos != std::string::npos; pos = io->output.find(style, pos + 1))
+        {
+            auto begin = pos + style.size();
+            words.push_back(std::to_string(index) + ":" + io->output.substr(begin, io->output.find('\033', begin) - begin));
+        }
+    }
+    return words;
+}
+
+TEST(HighlightTest, checkContentIsDrawnInStylesOfTokens)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    auto highlighter = std::make_shared<WordHighlighter>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    line.setHighlighter(highlighter);
+    line.setContent("if x # if y");
+    line.redraw();
+
+    auto keyword = highlighter->style(highlighter->keyword)->str();
+    auto comment = highlighter->style(highlighter->comment)->str();
+    EXPECT_NE(io->output.find(keyword + "if"), std::string::npos);
+    // the second "if" is in the comment, written in one run with it
+    EXPECT_NE(io->output.find(comment + "# if y"), std::string::npos);
+    EXPECT_EQ(io->output.find(keyword, io->output.find(keyword) + 1), std::string::npos);
+}
+
+TEST(HighlightTest, checkTokenBeforeEditIsStyledAgain)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    auto highlighter = std::make_shared<WordHighlighter>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    line.setHighlighter(highlighter);
+    Cursor cursor(line, io);
+    cursor.putChar('i');
+
+    // "i" becomes the keyword "if", so it is painted again with the typed character
+    io->output.clear();
+    cursor.putChar('f');
+    EXPECT_EQ(io->output, "\b" + highlighter->style(highlighter->keyword)->str() + "if" + std::string(Color::TERMINATOR));
+
+    // a plain word after it does not paint the keyword again
+    cursor.putText(" x");
+    io->output.clear();
+    cursor.putChar('y');
+    EXPECT_EQ(io->output, "y" + std::string(Color::TERMINATOR));
+}
+
+TEST(HighlightTest, checkStateIsCarriedPastTheEdit)
+{
+    auto highlighter = std::make_shared<WordHighlighter>();
+    Line line;
+    line.setHighlighter(highlighter);
+    line.append("a if b if");
+    EXPECT_EQ(styledWords(line, highlighter), (std::vector<std::string>{"1:if", "1:if"}));
+
+    // a comment started in front turns everything after it into comment
+    line.insert(2, "# ");
+    EXPECT_EQ(styledWords(line, highlighter), (std::vector<std::string>{"2:# if b if"}));
+
+    // and ending it brings the keywords back
+    line.erase(2, 2);
+    EXPECT_EQ(styledWords(line, highlighter), (std::vector<std::string>{"1:if", "1:if"}));
+    EXPECT_EQ(line.content(), "a if b if");
+}
+
+TEST(HighlightTest, checkEditLexesOnlyTokensAroundIt)
+{
+    for (std::size_t words : {250, 2500})
+    {
+        // 1 KB and 10 KB lines, typing and deleting in the middle
+        auto highlighter = std::make_shared<WordHighlighter>();
+        Line line;
+        line.setHighlighter(highlighter);
+        std::string text;
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            text += i % 2 ? "if " : "ab ";
+        }
+        line.append(text);
+        auto middle = int(text.size() / 2);
+        highlighter->lexed = 0;
+        for (int i = 0; i < 100; ++i)
+        {
+            line.insert(middle, 'x');
+            line.remove(middle);
+        }
+        EXPECT_LE(highlighter->lexed, 200 * 4) << "words: " << words;
+        EXPECT_EQ(line.content(), text);
+    }
+}
+
+TEST(HighlightTest, checkViewportIsDrawnInStylesOfTokens)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    auto highlighter = std::make_shared<WordHighlighter>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    line.setHighlighter(highlighter);
+    line.setViewport(20);
+    std::string text;
+    for (int i = 0; i < 100; ++i)
+    {
+        text += "ab if ";
+    }
+    line.setContent(text);
+    io->output.clear();
+    line.moveCursor(300);
+
+    // only the visible window is written, keywords in their style
+    auto keyword = highlighter->style(highlighter->keyword)->str();
+    EXPECT_NE(io->output.find(keyword + "if"), std::string::npos);
+    EXPECT_LT(io->output.size(), 200);
+}
@@ -53,3 +53,82 @@ TEST(HistoryTest, checkAfterRewindStartsAlwaysAtBegin)
     EXPECT_EQ(history.next(), "test2");
     EXPECT_EQ(history.next(), "test1");
 }
+
+TEST(HistoryTest, checkSuggestionIsMostRecentLineStartingWithPrefix)
+{
+    MemoryHistory history;
+    history.insert("git status");
+    history.insert("git commit");
+    history.insert("ls");
+    EXPECT_EQ(history.suggest("git"), "git commit");
+    EXPECT_EQ(history.suggest("git s"), "git status");
+    // a line is suggested only when it goes on past what was typed
+    EXPECT_EQ(history.suggest("ls"), "");
+    EXPECT_EQ(history.suggest("x"), "");
+
+    // entered again, a line becomes the most recent one
+    history.insert("git status");
+    EXPECT_EQ(history.suggest("git"), "git status");
+    EXPECT_EQ(history.length(), 3);
+    EXPECT_EQ(history.next(), "git status");
+
+    history.clear();
+    EXPECT_EQ(history.suggest("git"), "");
+}
+
+TEST(HistoryTest, checkLinesDroppedOverLimitAreNotSuggested)
+{
+    MemoryHistory history(2);
+    history.insert("make test");
+    history.insert("make");
+    history.insert("mkdir build");
+    EXPECT_EQ(history.length(), 2);
+    EXPECT_EQ(history.suggest("make "), "");
+    EXPECT_EQ(history.suggest("ma"), "make");
+    EXPECT_EQ(history.suggest("m"), "mkdir build");
+
+    history.insert("make all");
+    EXPECT_EQ(history.suggest("make"), "make all");
+    EXPECT_EQ(history.suggest("mk"), "mkdir build");
+}
+
+TEST(HistoryTest, checkSuggestionsAfterManyLinesDroppedOverLimit)
+{
+    MemoryHistory history(3);
+    for (int i = 0; i < 1000; ++i)
+    {
+        history.insert("echo " + std::to_string(i % 7) + std::string(std::size_t(i % 5), 'x'));
+    }
+    // the last three were "echo 3xx", "echo 4xxx" and "echo 5xxxx"
+    EXPECT_EQ(history.length(), 3);
+    EXPECT_EQ(history.suggest("echo"), "echo 5xxxx");
+    EXPECT_EQ(history.suggest("echo 3"), "echo 3xx");
+    EXPECT_EQ(history.suggest("echo 4x"), "echo 4xxx");
+    EXPECT_EQ(history.suggest("echo 2"), "");
+}
+
+TEST(HistoryTest, checkVeryLongLineIsSuggestedAndCleared)
+{
+    MemoryHistory history;
+    std::string line(200000, 'a');
+    history.insert(line);
+    history.insert(line + "b");
+    EXPECT_EQ(history.suggest("aaa"), line + "b");
+    EXPECT_EQ(history.suggest(line), line + "b");
+    history.clear();
+    EXPECT_EQ(history.suggest("aaa"), "");
+}
+
+TEST(HistoryTest, checkLineEnteredAgainMovesToFrontFromAnywhere)
+{
+    MemoryHistory history(4);
+    for (auto line : {"a", "b", "c", "d", "b", "a", "e", "b"})
+    {
+        history.insert(line);
+    }
+    // "c" was the oldest line when "e" came over the limit
+    EXPECT_EQ(history.lines(), (std::deque<std::string>{"b", "e", "a", "d"}));
+    EXPECT_EQ(history.suggest(""), "b");
+    history.insert("d");
+    EXPECT_EQ(history.lines(), (std::deque<std::string>{"d", "b", "e", "a"}));
+}
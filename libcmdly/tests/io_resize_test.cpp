@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <csignal>
+#include <gtest/gtest.h>
+#include "cmdly/io.h"
+#include "cmdly/terminal.h"
+
+using namespace cmdly;
+
+class ResizeTest : public ::testing::Test
+{
+protected:
+    int master_ = -1;
+    int slave_ = -1;
+
+    void SetUp() override
+    {
+        master_ = ::posix_openpt(O_RDWR | O_NOCTTY);
+        ASSERT_GE(master_, 0);
+        ASSERT_EQ(::grantpt(master_), 0);
+        ASSERT_EQ(::unlockpt(master_), 0);
+        slave_ = ::open(::ptsname(master_), O_RDWR | O_NOCTTY);
+        ASSERT_GE(slave_, 0);
+        resize(80, 24);
+    }
+
+    void TearDown() override
+    {
+        ::close(slave_);
+        ::close(master_);
+    }
+
+    void resize(unsigned short cols, unsigned short rows) const
+    {
+        struct winsize ws = {};
+        ws.ws_col = cols;
+        ws.ws_row = rows;
+        ::ioctl(master_, TIOCSWINSZ, &ws);
+    }
+};
+
+static volatile sig_atomic_t application_resizes = 0;
+
+// Declared first: the handler is installed once, by the first StandardIO on a terminal
+TEST_F(ResizeTest, checkHandlerOfApplicationIsChained)
+{
+    struct sigaction action{};
+    action.sa_handler = [](int) { application_resizes = application_resizes + 1; };
+    sigemptyset(&action.sa_mask);
+    struct sigaction previous{};
+    ASSERT_EQ(sigaction(SIGWINCH, &action, &previous), 0);
+
+    {
+        StandardIO io(slave_, slave_);
+        struct sigaction installed{};
+        sigaction(SIGWINCH, nullptr, &installed);
+        // other system calls of the process are not interrupted by a resize
+        EXPECT_TRUE(installed.sa_flags & SA_RESTART);
+
+        ::raise(SIGWINCH);
+        EXPECT_EQ(application_resizes, 1);
+        EXPECT_TRUE(io.checkResize());
+    }
+    ::raise(SIGWINCH);
+    EXPECT_EQ(application_resizes, 2);
+}
+
+TEST_F(ResizeTest, checkWindowSizeIsCachedUntilSignal)
+{
+    StandardIO io(slave_, slave_);
+    std::size_t cols, rows;
+    io.getWindowSize(&cols, &rows);
+    EXPECT_EQ(cols, 80);
+    EXPECT_EQ(rows, 24);
+    EXPECT_FALSE(io.checkResize());
+
+    // without the signal the cached size is still reported
+    resize(100, 30);
+    io.getWindowSize(&cols, &rows);
+    EXPECT_EQ(cols, 80);
+
+    ::raise(SIGWINCH);
+    io.getWindowSize(&cols, &rows);
+    EXPECT_EQ(cols, 100);
+    EXPECT_EQ(rows, 30);
+    EXPECT_GE(io.resizeDescriptor(), 0);
+    EXPECT_TRUE(io.checkResize());
+    EXPECT_FALSE(io.checkResize());
+}
+
+TEST_F(ResizeTest, checkGetKeyReportsResize)
+{
+    StandardIO io(slave_, slave_);
+    resize(120, 40);
+    ::raise(SIGWINCH);
+    EXPECT_EQ(io.getKey(), Key::Resize);
+
+    ASSERT_EQ(::write(master_, "a", 1), 1);
+    EXPECT_EQ(io.getKey(), Key('a'));
+}
+
+TEST_F(ResizeTest, checkResizeRedrawsLineOnce)
+{
+    auto io = std::make_shared<StandardIO>(slave_, slave_);
+    Terminal terminal(io);
+    terminal.start("> ");
+    ASSERT_EQ(::write(master_, "abc", 3), 3);
+    terminal.pollOnce(std::chrono::milliseconds(100));
+
+    // drain what was drawn so far
+    char buf[4096];
+    ::fcntl(master_, F_SETFL, O_NONBLOCK);
+    while (::read(master_, buf, sizeof(buf)) > 0)
+    {}
+
+    resize(60, 20);
+    ::raise(SIGWINCH);
+    terminal.pollOnce(std::chrono::milliseconds(100));
+
+    std::string output;
+    ssize_t len;
+    while ((len = ::read(master_, buf, sizeof(buf))) > 0)
+    {
+        output.append(buf, len);
+    }
+    EXPECT_EQ(std::count(output.begin(), output.end(), '\r'), 1);
+    EXPECT_NE(output.find("> "), std::string::npos);
+    EXPECT_NE(output.find("abc"), std::string::npos);
+    terminal.stop();
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <csignal>
+#include <functional>
+#include <gtest/gtest.h>
+#include "cmdly/io.h"
+
+using namespace cmdly;
+
+class SignalTest : public ::testing::Test
+{
+protected:
+    int masters_[2] = {-1, -1};
+    int slaves_[2] = {-1, -1};
+
+    void SetUp() override
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            masters_[i] = ::posix_openpt(O_RDWR | O_NOCTTY);
+            ASSERT_GE(masters_[i], 0);
+            ASSERT_EQ(::grantpt(masters_[i]), 0);
+            ASSERT_EQ(::unlockpt(masters_[i]), 0);
+            slaves_[i] = ::open(::ptsname(masters_[i]), O_RDWR | O_NOCTTY);
+            ASSERT_GE(slaves_[i], 0);
+        }
+    }
+
+    void TearDown() override
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            ::close(slaves_[i]);
+            ::close(masters_[i]);
+        }
+    }
+
+    // Runs body in a child process, which is expected to be killed by the SIGTERM it raises
+    static void killedChild(const std::function<void()> &body)
+    {
+        auto pid = ::fork();
+        ASSERT_GE(pid, 0);
+        if (pid == 0)
+        {
+            body();
+            ::_exit(0);
+        }
+        int status = 0;
+        ASSERT_EQ(::waitpid(pid, &status, 0), pid);
+        EXPECT_TRUE(WIFSIGNALED(status));
+        EXPECT_EQ(WTERMSIG(status), SIGTERM);
+    }
+
+    [[nodiscard]] bool isCooked(int i) const
+    {
+        struct termios term{};
+        ::tcgetattr(slaves_[i], &term);
+        return (term.c_lflag & ICANON) && (term.c_lflag & ECHO);
+    }
+};
+
+TEST_F(SignalTest, checkEveryTerminalInRawModeIsRestored)
+{
+    killedChild([this]() {
+        StandardIO first(slaves_[0], slaves_[0]);
+        StandardIO second(slaves_[1], slaves_[1]);
+        first.enterRawMode();
+        second.enterRawMode();
+        ::raise(SIGTERM);
+    });
+    EXPECT_TRUE(isCooked(0));
+    EXPECT_TRUE(isCooked(1));
+}
+
+TEST_F(SignalTest, checkTerminalStillInRawModeIsRestoredAfterAnotherLeft)
+{
+    killedChild([this]() {
+        StandardIO first(slaves_[0], slaves_[0]);
+        StandardIO second(slaves_[1], slaves_[1]);
+        first.enterRawMode();
+        second.enterRawMode();
+        first.exitRawMode();
+        ::raise(SIGTERM);
+    });
+    EXPECT_TRUE(isCooked(0));
+    EXPECT_TRUE(isCooked(1));
+}
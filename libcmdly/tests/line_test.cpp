@@ -3,7 +3,9 @@
  */
 
 #include <gtest/gtest.h>
+#include "cmdly/cursor.h"
 #include "cmdly/line.h"
+#include "helpers/io_mock.h"
 
 using namespace testing;
 using namespace cmdly;
@@ -53,4 +55,320 @@ TEST(LineTest, checkRemoveMethodWorksFine)
     line.remove(4);
     EXPECT_EQ(line.length(), 4);
     EXPECT_EQ(line.str(), "impl");
-}
\ No newline at end of file
+}
+
+TEST(LineTest, checkAppendingCostsConstantBytes)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+
+    std::vector<std::size_t> costs;
+    for (int i = 0; i < 2000; ++i)
+    {
+        io->output.clear();
+        cursor.putChar('x');
+        costs.push_back(io->output.size());
+    }
+    EXPECT_EQ(costs[10], costs.back());
+    EXPECT_LT(costs.back(), 32);
+}
+
+TEST(LineTest, checkOnlyChangedSuffixIsWritten)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+    cursor.putText("abcdef");
+
+    // deleting at the end erases the rest of the line
+    io->output.clear();
+    line.setContent("abc");
+    line.update();
+    EXPECT_EQ(io->output, "\b\b\b\033[K");
+
+    // a change in the middle rewrites from the first differing column only
+    io->output.clear();
+    line.setContent("aXc");
+    line.update();
+    EXPECT_EQ(io->output, "\b\b" + TextStyle().str() + "Xc" + std::string(Color::TERMINATOR));
+
+    // nothing changed, nothing written
+    io->output.clear();
+    line.update();
+    EXPECT_EQ(io->output, "");
+
+    // after invalidate() the whole line is drawn
+    line.invalidate();
+    line.update();
+    EXPECT_EQ(io->output.front(), '\r');
+    EXPECT_NE(io->output.find("aXc"), std::string::npos);
+}
+
+TEST(LineTest, checkColumnsOfWideAndCombiningCharacters)
+{
+    Line line;
+    line.append("a\xE6\xBC\xA2" "e\xCC\x81" "b");
+    EXPECT_EQ(line.length(), 8);
+    EXPECT_EQ(line.width(), 5);
+    EXPECT_EQ(line.columnAt(1), 1);
+    EXPECT_EQ(line.columnAt(4), 3);
+    EXPECT_EQ(line.columnAt(7), 4);
+    EXPECT_EQ(line.nextBoundary(1), 4);
+    EXPECT_EQ(line.nextBoundary(4), 7);
+    EXPECT_EQ(line.prevBoundary(7), 4);
+    EXPECT_EQ(line.prevBoundary(4), 1);
+
+    // a mark typed after a base joins its cluster
+    line.insert(8, "\xCC\x88");
+    EXPECT_EQ(line.width(), 5);
+    EXPECT_EQ(line.prevBoundary(10), 7);
+
+    // an edit in front shifts the clusters after it
+    line.insert(0, "\xE5\xAD\x97");
+    EXPECT_EQ(line.width(), 7);
+    EXPECT_EQ(line.columnAt(10), 6);
+
+    line.setContent("plain");
+    EXPECT_EQ(line.width(), 5);
+    EXPECT_EQ(line.nextBoundary(0), 1);
+}
+
+TEST(LineTest, checkClustersStayRightAfterEditsAnywhere)
+{
+    // ASCII, a wide character, a combining mark and a two-byte letter, edited at random places
+    const std::vector<std::string> pieces{"a", "\xE6\xBC\xA2", "\xCC\x81", "\xC3\xA9", "bc"};
+    std::uint32_t seed = 7;
+    auto random = [&seed](std::size_t n) {
+        seed = seed * 1103515245 + 12345;
+        return std::size_t(seed >> 16) % n;
+    };
+    Line line;
+    for (int i = 0; i < 600; ++i)
+    {
+        auto index = line.length() > 0 ? random(line.length() + 1) : 0;
+        index = index < line.length() ? line.prevBoundary(line.nextBoundary(index)) : index;
+        if (random(3) == 0 && index < line.length())
+        {
+            line.erase(index, line.nextBoundary(index) - index);
+        }
+        else
+        {
+            line.insert(int(index), pieces[random(pieces.size())]);
+        }
+
+        Line fresh;
+        fresh.setContent(line.content());
+        ASSERT_EQ(line.width(), fresh.width());
+        for (std::size_t j = 0; j < line.length(); j = fresh.nextBoundary(j))
+        {
+            ASSERT_EQ(line.columnAt(j), fresh.columnAt(j));
+            ASSERT_EQ(line.nextBoundary(j), fresh.nextBoundary(j));
+        }
+    }
+}
+
+TEST(LineTest, checkClustersStayRightAfterEditsInsideCharacters)
+{
+    // edits at any byte, splitting characters and leaving stray continuation bytes
+    const std::vector<std::string> pieces{"a", "\xE6\xBC\xA2", "\xCC\x81", "\xC3\xA9", "\xA9", "\xE6"};
+    std::uint32_t seed = 11;
+    auto random = [&seed](std::size_t n) {
+        seed = seed * 1103515245 + 12345;
+        return std::size_t(seed >> 16) % n;
+    };
+    Line line;
+    for (int i = 0; i < 600; ++i)
+    {
+        auto index = line.length() > 0 ? random(line.length() + 1) : 0;
+        if (random(3) == 0 && index < line.length())
+        {
+            line.erase(index, 1 + random(3));
+        }
+        else
+        {
+            line.insert(int(index), pieces[random(pieces.size())]);
+        }
+
+        Line fresh;
+        fresh.setContent(line.content());
+        ASSERT_EQ(line.width(), fresh.width());
+        for (std::size_t j = 0; j < line.length(); j = fresh.nextBoundary(j))
+        {
+            ASSERT_EQ(line.columnAt(j), fresh.columnAt(j));
+            ASSERT_EQ(line.nextBoundary(j), fresh.nextBoundary(j));
+        }
+    }
+}
+
+TEST(LineTest, checkCursorMovesOverWholeCharacters)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+    cursor.putText("\xE6\xBC\xA2" "e\xCC\x81");
+    EXPECT_EQ(cursor.col(), 6);
+
+    // the accented e is one column left, the wide character two
+    io->output.clear();
+    cursor.moveLeft();
+    EXPECT_EQ(io->output, "\b");
+    io->output.clear();
+    cursor.moveLeft();
+    EXPECT_EQ(io->output, "\b\b");
+    EXPECT_EQ(cursor.index(), 2);
+    cursor.moveRight();
+    EXPECT_EQ(cursor.index(), 5);
+
+    // backspace removes the whole wide character
+    cursor.eatChar();
+    EXPECT_EQ(line.content(), "e\xCC\x81");
+    EXPECT_EQ(cursor.col(), 3);
+    cursor.moveToEnd();
+    cursor.eatChar();
+    EXPECT_EQ(line.content(), "");
+}
+
+TEST(LineTest, checkRemovingMarkRewritesItsCluster)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+    cursor.putText("xe\xCC\x81");
+
+    io->output.clear();
+    line.setContent("xe");
+    line.update();
+    EXPECT_EQ(io->output, "\b" + TextStyle().str() + "e" + std::string(Color::TERMINATOR));
+}
+
+TEST(LineTest, checkEditsInLongLineRenderTheTailOnly)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    Cursor cursor(line, io);
+    cursor.putText(std::string(100000, 'x'));
+    for (int i = 0; i < 10; ++i)
+    {
+        cursor.moveLeft();
+    }
+
+    io->output.clear();
+    auto revision = line.revision();
+    cursor.putChar('y');
+    EXPECT_NE(line.revision(), revision);
+    EXPECT_LT(io->output.size(), 64);
+    EXPECT_EQ(line.content().size(), 100001);
+    EXPECT_EQ(line.content().substr(99990), "yxxxxxxxxxx");
+}
+
+TEST(LineTest, checkLongLineScrollsInsideViewport)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    line.setViewport(20);
+    Cursor cursor(line, io);
+    cursor.putText("0123456789abcdefghijklmnopqrstuvwxyz");
+
+    // the end of the line is shown with a marker on the left, the cursor stays inside the window
+    EXPECT_GT(line.scrollOffset(), 0);
+    EXPECT_EQ(line.screenColumn(), 2 + 36 - line.scrollOffset() + 1);
+    EXPECT_LT(line.screenColumn(), 20);
+    auto last_draw = io->output.substr(io->output.rfind('\r'));
+    EXPECT_NE(last_draw.find("<"), std::string::npos);
+    EXPECT_NE(last_draw.find("xyz"), std::string::npos);
+    EXPECT_EQ(last_draw.find(">", last_draw.find("<")), std::string::npos);
+
+    // going home scrolls back, the rest is marked on the right
+    io->output.clear();
+    cursor.moveToHome();
+    EXPECT_EQ(line.scrollOffset(), 0);
+    EXPECT_EQ(line.screenColumn(), 3);
+    EXPECT_NE(io->output.find("0123456789abcdef"), std::string::npos);
+    EXPECT_NE(io->output.find(">"), std::string::npos);
+    EXPECT_EQ(io->output.find("xyz"), std::string::npos);
+
+    // moving inside the window is a cursor move only
+    io->output.clear();
+    cursor.moveRight();
+    EXPECT_EQ(io->output, "\033[C");
+}
+
+TEST(LineTest, checkViewportRedrawCostDependsOnWidth)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    line.setViewport(80);
+    Cursor cursor(line, io);
+    cursor.putText(std::string(100000, 'x'));
+    cursor.moveToHome();
+    for (int i = 0; i < 10; ++i)
+    {
+        cursor.moveRight();
+    }
+
+    io->output.clear();
+    cursor.putChar('y');
+    EXPECT_LT(io->output.size(), 160);
+
+    // back below the width the line is drawn whole again
+    line.setContent("short");
+    line.update();
+    cursor.moveToEnd();
+    EXPECT_EQ(line.scrollOffset(), 0);
+    EXPECT_EQ(line.screenColumn(), 8);
+}
+
+TEST(LineTest, checkViewportLeavesCutWideCharacterBlank)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    line.setViewport(12);
+    Cursor cursor(line, io);
+    std::string wide;
+    for (int i = 0; i < 4; ++i)
+    {
+        wide += "\xE6\xBC\xA2\xE5\xAD\x97";
+    }
+    cursor.putText(wide);
+
+    // the wide character next to the marker would be cut in half, a space is shown in its place
+    auto last_draw = io->output.substr(io->output.rfind('\r'));
+    EXPECT_NE(last_draw.find("< \xE5\xAD\x97"), std::string::npos);
+    EXPECT_EQ(line.screenColumn(), 7);
+}
+
+TEST(LineTest, checkSuggestionIsDrawnAfterContentAndErased)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("> ", TextStyle(), TextStyle(), io);
+    line.setViewport(12);
+    Cursor cursor(line, io);
+    cursor.putText("ab");
+    auto dimmed = TextStyle(Color::Default, Color::Default, FontStyle::Faint).str();
+
+    // only what fits before the last column is shown, the cursor goes back to the content
+    io->output.clear();
+    line.setSuggestion("cdefghijkl");
+    line.update();
+    cursor.sync();
+    EXPECT_EQ(io->output, dimmed + "cdefghi" + std::string(Color::TERMINATOR) + "\033[7D");
+
+    // a shorter one erases the rest of the old one
+    io->output.clear();
+    line.setSuggestion("cd");
+    line.update();
+    cursor.sync();
+    EXPECT_EQ(io->output, dimmed + "cd" + std::string(Color::TERMINATOR) + "\033[K\b\b");
+
+    io->output.clear();
+    line.acceptSuggestion();
+    line.update();
+    cursor.moveToEnd();
+    EXPECT_EQ(line.content(), "abcd");
+    EXPECT_EQ(io->output, "cd" + std::string(Color::TERMINATOR));
+
+    io->output.clear();
+    line.hideSuggestion();
+    EXPECT_EQ(io->output, "");
+}
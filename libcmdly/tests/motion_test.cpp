@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/cursor.h"
+#include "helpers/io_mock.h"
+
+using namespace cmdly;
+
+// Typing a command, fixing a typo in the middle, jumping around and deleting, key by key
+static std::size_t runEditingScript(const TextStyle &content_style)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    Line line("cmdly> ", TextStyle(Color::Green), content_style, io);
+    Cursor cursor(line, io);
+    io->output.clear();
+
+    for (char c : std::string("git comit -m 'first version'"))
+    {
+        cursor.putChar(c);
+    }
+    cursor.moveToHome();
+    for (int i = 0; i < 7; ++i)
+    {
+        cursor.moveRight();
+    }
+    cursor.putChar('m');
+    cursor.moveToEnd();
+    for (int i = 0; i < 8; ++i)
+    {
+        cursor.moveLeft();
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+        cursor.eatChar();
+    }
+    for (char c : std::string("second"))
+    {
+        cursor.putChar(c);
+    }
+    cursor.moveToHome();
+    cursor.moveToEnd();
+    for (int i = 0; i < 3; ++i)
+    {
+        cursor.moveLeft();
+        cursor.moveRight();
+    }
+    for (int i = 0; i < 20; ++i)
+    {
+        cursor.moveLeft();
+    }
+    cursor.moveToEnd();
+    return io->output.size();
+}
+
+TEST(MotionTest, checkCheapestMoveIsPlanned)
+{
+    using Kind = CursorMotion::Kind;
+    EXPECT_EQ(CursorMotion::plan(5, 5).kind, Kind::None);
+    // one or two steps left are backspaces, far left is a relative move or a return
+    EXPECT_EQ(CursorMotion::plan(5, 4).kind, Kind::Backspaces);
+    EXPECT_EQ(CursorMotion::plan(5, 4).cost, 1);
+    EXPECT_EQ(CursorMotion::plan(40, 30).kind, Kind::Backward);
+    EXPECT_EQ(CursorMotion::plan(40, 30).cost, 5);
+    EXPECT_EQ(CursorMotion::plan(40, 1).kind, Kind::HomeForward);
+    EXPECT_EQ(CursorMotion::plan(40, 1).cost, 1);
+    EXPECT_EQ(CursorMotion::plan(140, 2).kind, Kind::HomeForward);
+    EXPECT_EQ(CursorMotion::plan(140, 3).kind, Kind::Column);
+    // right: plain characters are rewritten when that is shorter
+    EXPECT_EQ(CursorMotion::plan(5, 6).kind, Kind::Forward);
+    EXPECT_EQ(CursorMotion::plan(5, 7, 2).kind, Kind::Rewrite);
+    EXPECT_EQ(CursorMotion::plan(5, 25, 20).kind, Kind::Forward);
+    // far into a long row the absolute column is shorter than a return and a relative move
+    EXPECT_EQ(CursorMotion::plan(1500, 150).kind, Kind::Column);
+}
+
+TEST(MotionTest, checkPlansAreWrittenAsPriced)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    for (auto [from, to] : {std::pair{5, 4}, {40, 30}, {40, 1}, {140, 2}, {140, 3}, {5, 6}, {1500, 150}, {150, 1500}})
+    {
+        io->output.clear();
+        auto plan = CursorMotion::plan(std::size_t(from), std::size_t(to));
+        CursorMotion::write(*io, plan, std::size_t(from), std::size_t(to));
+        EXPECT_EQ(io->output.size(), plan.cost) << from << " -> " << to;
+    }
+    io->output.clear();
+    CursorMotion::write(*io, CursorMotion::plan(1500, 150), 1500, 150);
+    EXPECT_EQ(io->output, "\033[150G");
+}
+
+// Bytes written for the script with relative moves only (ESC[nC / ESC[nD), before the planner, and
+// with the planner
+static constexpr std::size_t RELATIVE_PLAIN_BYTES = 600;
+static constexpr std::size_t RELATIVE_STYLED_BYTES = 969;
+static constexpr std::size_t PLANNED_PLAIN_BYTES = 457;
+static constexpr std::size_t PLANNED_STYLED_BYTES = 846;
+
+TEST(MotionTest, checkEditingScriptBytes)
+{
+    auto plain = runEditingScript(TextStyle());
+    auto styled = runEditingScript(TextStyle(Color::Blue));
+    RecordProperty("relative_plain_bytes", RELATIVE_PLAIN_BYTES);
+    RecordProperty("planned_plain_bytes", plain);
+    RecordProperty("relative_styled_bytes", RELATIVE_STYLED_BYTES);
+    RecordProperty("planned_styled_bytes", styled);
+    EXPECT_EQ(plain, PLANNED_PLAIN_BYTES);
+    EXPECT_EQ(styled, PLANNED_STYLED_BYTES);
+}
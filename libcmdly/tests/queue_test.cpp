@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "cmdly/queue.h"
+
+using namespace cmdly;
+
+TEST(QueueTest, checkFifoOrder)
+{
+    MpscQueue<int> queue;
+    EXPECT_TRUE(queue.empty());
+    queue.push(1);
+    queue.push(2);
+    EXPECT_FALSE(queue.empty());
+    EXPECT_EQ(queue.pop(), 1);
+    EXPECT_EQ(queue.pop(), 2);
+    EXPECT_EQ(queue.pop(), std::nullopt);
+}
+
+TEST(QueueTest, checkConcurrentProducers)
+{
+    constexpr int PRODUCERS = 4;
+    constexpr int MESSAGES = 10000;
+    MpscQueue<std::pair<int, int>> queue;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < MESSAGES; ++i)
+            {
+                queue.push({p, i});
+            }
+        });
+    }
+
+    // the consumer runs alongside the producers, every producer's messages come out in order
+    std::vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    while (received < PRODUCERS * MESSAGES)
+    {
+        if (auto message = queue.pop())
+        {
+            EXPECT_EQ(message->second, next[message->first]);
+            next[message->first] = message->second + 1;
+            received++;
+        }
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
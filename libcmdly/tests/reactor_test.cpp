@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <unistd.h>
+#include <gtest/gtest.h>
+#include "cmdly/reactor.h"
+
+using namespace testing;
+using namespace cmdly;
+
+TEST(ReactorTest, checkReadableDescriptorIsDispatched)
+{
+    Reactor reactor;
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+
+    std::string received;
+    reactor.add(fds[0], EPOLLIN, [&received, &fds](std::uint32_t events) {
+        EXPECT_TRUE(events & EPOLLIN);
+        char buf[16];
+        auto len = ::read(fds[0], buf, sizeof(buf));
+        received.append(buf, len);
+    });
+
+    EXPECT_EQ(reactor.poll(std::chrono::milliseconds(0)), 0);
+    ASSERT_EQ(::write(fds[1], "data", 4), 4);
+    EXPECT_EQ(reactor.poll(std::chrono::milliseconds(100)), 1);
+    EXPECT_EQ(received, "data");
+
+    reactor.remove(fds[0]);
+    EXPECT_FALSE(reactor.contains(fds[0]));
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(ReactorTest, checkTimerFiresAndCanRemoveItself)
+{
+    Reactor reactor;
+    int fired = 0;
+    int timer = -1;
+    timer = reactor.addTimer(std::chrono::milliseconds(1), std::chrono::milliseconds(1), [&]() {
+        if (++fired == 2)
+        {
+            reactor.removeTimer(timer);
+        }
+    });
+
+    while (reactor.contains(timer))
+    {
+        reactor.poll(std::chrono::milliseconds(100));
+    }
+    EXPECT_EQ(fired, 2);
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <deque>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include "cmdly/recording.h"
+#include "cmdly/terminal.h"
+#include "helpers/io_mock.h"
+
+using namespace cmdly;
+
+class ScriptedIOMock : public OutputIOMock
+{
+public:
+    std::deque<Key> keys;
+
+    Key getKey() override
+    {
+        auto key = keys.front();
+        keys.pop_front();
+        return key;
+    }
+
+    void getWindowSize(std::size_t *cols, std::size_t *rows) const override
+    {
+        *cols = 100;
+        *rows = 40;
+    }
+};
+
+class RecordingTest : public ::testing::Test
+{
+protected:
+    std::string path = (std::filesystem::temp_directory_path() / "cmdly_recording_test.log").string();
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    std::string record(const std::vector<Key> &keys)
+    {
+        auto io = std::make_shared<ScriptedIOMock>();
+        io->keys.assign(keys.begin(), keys.end());
+        Terminal terminal(std::make_shared<RecordingIO>(io, path));
+        return terminal.readLine("> ");
+    }
+};
+
+TEST_F(RecordingTest, checkLogHasInputOutputAndSize)
+{
+    EXPECT_EQ(record({Key('a'), Key('b'), Key::Enter}), "ab");
+
+    auto events = SessionLog::load(path);
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(events.front().type, SessionEvent::Type::Resize);
+    std::size_t cols, rows;
+    SessionLog::decodeSize(events.front().data, &cols, &rows);
+    EXPECT_EQ(cols, 100);
+    EXPECT_EQ(rows, 40);
+
+    std::string input;
+    std::size_t output_bytes = 0;
+    auto time = std::chrono::nanoseconds(0);
+    for (auto &event : events)
+    {
+        EXPECT_GE(event.time, time);
+        time = event.time;
+        if (event.type == SessionEvent::Type::Input)
+        {
+            input += event.data;
+        }
+        if (event.type == SessionEvent::Type::Output)
+        {
+            output_bytes += event.data.size();
+        }
+    }
+    EXPECT_EQ(input, "ab\r");
+    EXPECT_GT(output_bytes, 0);
+}
+
+TEST_F(RecordingTest, checkReplayReproducesSession)
+{
+    auto line = record({Key('a'), Key('c'), Key::ArrowLeft, Key('b'), Key::Esc,
+                        Key::Pasted("de"), Key::Resize, Key::Enter});
+    EXPECT_EQ(line, "abdec");
+
+    auto io = std::make_shared<ReplayIO>(path);
+    Terminal terminal(io);
+    EXPECT_EQ(terminal.readLine("> "), line);
+    EXPECT_TRUE(io->finished());
+
+    auto &timings = io->timings();
+    ASSERT_EQ(timings.size(), 8);
+    std::size_t output_bytes = 0;
+    for (auto &timing : timings)
+    {
+        output_bytes += timing.output_bytes;
+    }
+    EXPECT_GT(output_bytes, 0);
+}
+
+TEST_F(RecordingTest, checkLoadRejectsOtherFiles)
+{
+    std::ofstream(path) << "not a session";
+    EXPECT_THROW(SessionLog::load(path), IOError);
+    EXPECT_THROW(SessionLog::load(path + ".missing"), IOError);
+}
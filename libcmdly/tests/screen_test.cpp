@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/screen.h"
+#include "helpers/io_mock.h"
+
+using namespace testing;
+using namespace cmdly;
+
+TEST(ScreenTest, checkOnlyChangedCellsAreWritten)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    CellGrid grid;
+    grid.resize(3, 20);
+    auto inverted = grid.addStyle(TextStyle(Color::Default, Color::Default, FontStyle::Invert));
+    grid.put(0, 0, "alpha");
+    grid.put(0, 10, "beta");
+    grid.put(2, 0, "gamma");
+    grid.flush(*io);
+    EXPECT_EQ(io->output, "\0337\033[B\033[Galpha\033[5Cbeta\033[2B\rgamma\0338");
+
+    // nothing changed, nothing written
+    io->output.clear();
+    grid.put(0, 0, "alpha");
+    grid.flush(*io);
+    EXPECT_EQ(io->output, "");
+
+    // a style changed on one word writes that word only
+    io->output.clear();
+    grid.put(0, 10, "beta", inverted);
+    grid.flush(*io);
+    auto style = TextStyle(Color::Default, Color::Default, FontStyle::Invert).str();
+    EXPECT_EQ(io->output, "\0337\033[B\033[11G" + style + "beta" + std::string(Color::TERMINATOR) + "\0338");
+
+    // a shorter word writes the cells that differ and erases what is left of the longer one
+    io->output.clear();
+    grid.put(2, 0, "gam");
+    grid.erase(2, 3, 2);
+    grid.flush(*io);
+    EXPECT_EQ(io->output, "\0337\033[3B\033[4G\033[K\0338");
+}
+
+TEST(ScreenTest, checkClearErasesOnlyWhatWasDrawn)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    CellGrid grid;
+    grid.resize(4, 20);
+    grid.put(1, 5, "word");
+    grid.flush(*io);
+
+    io->output.clear();
+    grid.clear();
+    grid.flush(*io);
+    EXPECT_EQ(io->output, "\0337\033[2B\033[6G\033[K\0338");
+    EXPECT_FALSE(grid.isDamaged());
+}
+
+TEST(ScreenTest, checkWideCharactersTakeTwoCells)
+{
+    auto io = std::make_shared<OutputIOMock>();
+    CellGrid grid;
+    grid.resize(1, 6);
+    EXPECT_EQ(grid.put(0, 0, "a\xE6\xBC\xA2" "b"), 4);
+    // what does not fit in the row is cut
+    EXPECT_EQ(grid.put(0, 4, "\xE6\xBC\xA2\xE6\xBC\xA2"), 2);
+    grid.flush(*io);
+    EXPECT_EQ(io->output, "\0337\033[B\033[Ga\xE6\xBC\xA2" "b\xE6\xBC\xA2\0338");
+
+    // overwriting half of a wide character blanks the other half
+    io->output.clear();
+    grid.put(0, 2, "c");
+    grid.flush(*io);
+    EXPECT_EQ(io->output, "\0337\033[B\033[2G c\0338");
+}
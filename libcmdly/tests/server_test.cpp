@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <cstring>
+#include <thread>
+#include <gtest/gtest.h>
+#include "cmdly/server.h"
+
+using namespace cmdly;
+
+class ServerTest : public ::testing::Test
+{
+protected:
+    std::string path = "/tmp/cmdly_server_test_" + std::to_string(::getpid()) + ".sock";
+    std::unique_ptr<SessionServer> server;
+
+    void SetUp() override
+    {
+        server = std::make_unique<SessionServer>(path, [](Terminal &terminal) {
+            terminal.onLineEntered([](const std::string &line, Terminal &terminal) {
+                if (line == "ping")
+                {
+                    terminal.writeText("pong\n");
+                    return LineEnteredListener::Status::CONTINUE;
+                }
+                if (line == "flood")
+                {
+                    for (int i = 0; i < 12; ++i)
+                    {
+                        terminal.writeText(std::string(40000, 'x') + "\n");
+                    }
+                    terminal.writeText("done\n");
+                    return LineEnteredListener::Status::CONTINUE;
+                }
+                return LineEnteredListener::Status::OK;
+            });
+            terminal.onKeyPressed(Key::Esc, [](const Key &, Line &, Cursor &, Terminal &terminal) {
+                terminal.writeText("escaped\n");
+                return KeyPressedListener::Status::CONTINUE;
+            });
+        });
+        server->start();
+    }
+
+    [[nodiscard]] int connect() const
+    {
+        int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        struct sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+        EXPECT_EQ(::connect(fd, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)), 0);
+        return fd;
+    }
+
+    // Reads until the text shows up, empty when the connection was closed or nothing came in time
+    static std::string readUntil(int fd, const std::string &text)
+    {
+        std::string output;
+        struct pollfd pfd = {fd, POLLIN, 0};
+        while (output.find(text) == std::string::npos && ::poll(&pfd, 1, 2000) > 0)
+        {
+            char buf[1024];
+            auto len = ::read(fd, buf, sizeof(buf));
+            if (len <= 0)
+            {
+                return "";
+            }
+            output.append(buf, len);
+        }
+        return output.find(text) == std::string::npos ? "" : output;
+    }
+
+    void waitForSessions(std::size_t count) const
+    {
+        for (int i = 0; i < 200 && server->sessions() != count; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        EXPECT_EQ(server->sessions(), count);
+    }
+};
+
+TEST_F(ServerTest, checkSessionsAreIndependent)
+{
+    std::vector<int> clients;
+    for (int i = 0; i < 50; ++i)
+    {
+        clients.push_back(connect());
+    }
+    for (int fd : clients)
+    {
+        EXPECT_FALSE(readUntil(fd, "> ").empty());
+    }
+    waitForSessions(50);
+
+    for (int fd : clients)
+    {
+        ASSERT_EQ(::write(fd, "ping\r", 5), 5);
+    }
+    for (int fd : clients)
+    {
+        EXPECT_FALSE(readUntil(fd, "pong").empty());
+    }
+
+    for (int fd : clients)
+    {
+        ::close(fd);
+    }
+    waitForSessions(0);
+}
+
+TEST_F(ServerTest, checkExitClosesConnection)
+{
+    int fd = connect();
+    readUntil(fd, "> ");
+    ASSERT_EQ(::write(fd, "exit\r", 5), 5);
+    EXPECT_FALSE(readUntil(fd, "bye!").empty());
+    waitForSessions(0);
+
+    char c;
+    EXPECT_EQ(::read(fd, &c, 1), 0);
+    ::close(fd);
+}
+
+TEST_F(ServerTest, checkLonelyEscIsDeliveredAfterTimeout)
+{
+    int fd = connect();
+    readUntil(fd, "> ");
+    ASSERT_EQ(::write(fd, "\033", 1), 1);
+    EXPECT_FALSE(readUntil(fd, "escaped").empty());
+    ::close(fd);
+    waitForSessions(0);
+}
+
+TEST_F(ServerTest, checkOutputKeptForSlowPeerIsSentLater)
+{
+    int fd = connect();
+    readUntil(fd, "> ");
+    ASSERT_EQ(::write(fd, "flood\r", 6), 6);
+    // the peer does not read for a while, the rest of the output waits for room in the socket
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(readUntil(fd, "done").empty());
+    ASSERT_EQ(::write(fd, "ping\r", 5), 5);
+    EXPECT_FALSE(readUntil(fd, "pong").empty());
+    ::close(fd);
+    waitForSessions(0);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <gtest/gtest.h>
+#include "cmdly/cursor.h"
+#include "cmdly/style.h"
+#include "helpers/io_mock.h"
+
+using namespace cmdly;
+
+// Allocations are counted while counting is set. The replacements are kept out of line: inlined,
+// the compiler would see free() called on what operator new returned and take it for a mismatch.
+static std::atomic<bool> counting{false};
+static std::atomic<std::size_t> allocations{0};
+
+[[gnu::noinline]] void *operator new(std::size_t size)
+{
+    if (counting)
+    {
+        allocations++;
+    }
+    if (void *p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// common styles are folded into constants
+static_assert(TextStyle(Color::Green).view() == "\033[38;5;2m");
+static_assert(TextStyle(Color::Red, Color::White, FontStyle::Bold | FontStyle::Underline).view() ==
+              "\033[38;5;1m\033[48;5;7m\033[1m\033[4m");
+static_assert(TextStyle::Default.view().empty());
+static_assert(TextStyle(Color(255)).view() == "\033[38;5;255m");
+static_assert(CursorStyle::Default.view() == "\033]112\007");
+static_assert(CursorStyle(RgbColor::Blue).view() == "\033]12;#006fb8\033\\");
+static_assert(TextStyle(Color::Blue) != TextStyle(Color::Cyan));
+
+TEST(StyleTest, checkConvertersMatchStyles)
+{
+    EXPECT_EQ(ColorConverter::foregroundTextColorToCodeSequence(Color::Green), "\033[38;5;2m");
+    EXPECT_EQ(ColorConverter::backgroundTextColorToCodeSequence(Color::Default), "");
+    EXPECT_EQ(ColorConverter::fontStyleToCodeSequence(FontStyle::Strike | FontStyle::Bold), "\033[1m\033[9m");
+    EXPECT_EQ(ColorConverter::cursorRgbColorToCodeSequence(RgbColor(1, 2, 255)), "\033]12;#0102ff\033\\");
+    EXPECT_EQ(TextStyle(Color::Yellow).str(), std::string(TextStyle(Color::Yellow).view()));
+}
+
+class NullIOMock : public IOMock
+{
+public:
+    mutable std::size_t bytes = 0;
+
+    void write(const std::string &data) const override
+    {
+        bytes += data.size();
+    }
+};
+
+TEST(StyleTest, checkStyledLineRendersWithoutAllocating)
+{
+    auto io = std::make_shared<NullIOMock>();
+    Line line("> ", TextStyle(Color::Green), TextStyle(Color::Blue, Color::Default, FontStyle::Bold), io);
+    Cursor cursor(line, io);
+    cursor.putText("some command with arguments");
+    for (int i = 0; i < 5; ++i)
+    {
+        cursor.moveLeft();
+    }
+    // the first edits size the buffers
+    cursor.putChar('x');
+    cursor.eatChar();
+
+    counting = true;
+    for (int i = 0; i < 100; ++i)
+    {
+        cursor.putChar('x');
+        cursor.moveLeft();
+        cursor.moveRight();
+        cursor.eatChar();
+        line.invalidate();
+        line.update();
+    }
+    counting = false;
+    EXPECT_EQ(allocations.load(), 0);
+    EXPECT_GT(io->bytes, 0);
+}
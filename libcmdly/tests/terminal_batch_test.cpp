@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <deque>
+#include <gtest/gtest.h>
+#include "cmdly/terminal.h"
+#include "helpers/io_mock.h"
+
+using namespace testing;
+using namespace cmdly;
+
+class BatchIOMock : public IOMock
+{
+public:
+    std::deque<std::string> chunks;
+    mutable std::vector<std::string> writes;
+
+    [[nodiscard]] bool isInteractive() const override
+    {
+        return false;
+    }
+
+    std::optional<std::string> readAvailable() override
+    {
+        if (chunks.empty())
+        {
+            return std::nullopt;
+        }
+        auto chunk = chunks.front();
+        chunks.pop_front();
+        return chunk;
+    }
+
+    void write(const std::string &data) const override
+    {
+        writes.push_back(data);
+    }
+};
+
+class BatchTerminalTest : public Test
+{
+protected:
+    std::shared_ptr<BatchIOMock> io = std::make_shared<BatchIOMock>();
+    std::unique_ptr<Terminal> terminal;
+    std::vector<std::string> lines;
+
+    void SetUp() override
+    {
+        terminal = std::make_unique<Terminal>(io);
+        terminal->onLineEntered([this](const std::string &line, Terminal &terminal) {
+            lines.push_back(line);
+            terminal.writeText(line + "\n", TextStyle(Color::Red));
+            return LineEnteredListener::Status::OK;
+        });
+    }
+};
+
+TEST_F(BatchTerminalTest, checkLinesSplitAcrossReads)
+{
+    io->chunks = {"first\r\nsec", "ond\n  third  \n", "last"};
+    terminal->run("> ");
+
+    EXPECT_EQ(lines, std::vector<std::string>({"first", "second", "third", "last"}));
+    EXPECT_TRUE(terminal->history()->lines().empty());
+}
+
+TEST_F(BatchTerminalTest, checkOutputHasNoControlSequences)
+{
+    io->chunks = {"one\ntwo\n"};
+    terminal->bell();
+    terminal->run("> ");
+
+    // one write per read, no prompt, no styles
+    ASSERT_EQ(io->writes.size(), 2);
+    EXPECT_EQ(io->writes[0], "\a");
+    EXPECT_EQ(io->writes[1], "one\ntwo\n");
+}
+
+TEST_F(BatchTerminalTest, checkExitStopsReading)
+{
+    io->chunks = {"one\nexit\ntwo\n"};
+    terminal->run("> ");
+
+    EXPECT_EQ(lines, std::vector<std::string>({"one"}));
+}
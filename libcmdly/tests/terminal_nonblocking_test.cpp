@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/terminal.h"
+#include "helpers/io_mock.h"
+
+using namespace testing;
+using namespace cmdly;
+
+class FeedIOMock : public IOMock
+{
+public:
+    std::string position = "\033[1;1R";
+    std::size_t position_index = 0;
+
+    char getChar() override
+    {
+        char c = position[position_index];
+        position_index = (position_index + 1) % position.size();
+        return c;
+    }
+};
+
+class NonBlockingTerminalTest : public Test
+{
+protected:
+    std::shared_ptr<FeedIOMock> io = std::make_shared<FeedIOMock>();
+    std::unique_ptr<Terminal> terminal;
+    std::vector<std::string> lines;
+
+    void SetUp() override
+    {
+        EXPECT_CALL(*io, write(_)).Times(AnyNumber());
+        terminal = std::make_unique<Terminal>(io);
+        terminal->onLineEntered([this](const std::string &line, Terminal &) {
+            lines.push_back(line);
+            return LineEnteredListener::Status::OK;
+        });
+    }
+};
+
+TEST_F(NonBlockingTerminalTest, checkFedBytesAreEnteredAsLines)
+{
+    terminal->start("prompt> ");
+    EXPECT_TRUE(terminal->isRunning());
+    terminal->feed("ab");
+    EXPECT_TRUE(lines.empty());
+    terminal->feed("c\rdef\r");
+    EXPECT_EQ(lines, std::vector<std::string>({"abc", "def"}));
+    EXPECT_TRUE(terminal->isRunning());
+}
+
+TEST_F(NonBlockingTerminalTest, checkSequenceSplitAcrossFeedsIsOneKey)
+{
+    terminal->start("prompt> ");
+    terminal->feed("x\033");
+    terminal->feed("[D");
+    terminal->feed("y\r");
+    EXPECT_EQ(lines, std::vector<std::string>({"yx"}));
+}
+
+TEST_F(NonBlockingTerminalTest, checkLonelyEscIsDeliveredAfterTimeout)
+{
+    int esc_count = 0;
+    terminal->onKeyPressed(Key::Esc, [&esc_count](const cmdly::Key &, Line &, Cursor &, Terminal &) {
+        esc_count++;
+        return KeyPressedListener::Status::CONTINUE;
+    });
+    terminal->setEscTimeout(std::chrono::milliseconds(0));
+    terminal->start("prompt> ");
+    terminal->feed("\033");
+    EXPECT_EQ(esc_count, 0);
+    EXPECT_TRUE(terminal->pollOnce(std::chrono::milliseconds(0)));
+    EXPECT_EQ(esc_count, 1);
+}
+
+TEST_F(NonBlockingTerminalTest, checkExitStopsTerminal)
+{
+    terminal->start("prompt> ");
+    terminal->feed("exit\rignored\r");
+    EXPECT_FALSE(terminal->isRunning());
+    EXPECT_FALSE(terminal->pollOnce(std::chrono::milliseconds(0)));
+    EXPECT_TRUE(lines.empty());
+}
+
+TEST_F(NonBlockingTerminalTest, checkApplicationTimerRunsInTerminalLoop)
+{
+    int ticks = 0;
+    terminal->start("prompt> ");
+    int timer = terminal->reactor()->addTimer(std::chrono::milliseconds(1), std::chrono::milliseconds(1), [&ticks]() {
+        ticks++;
+    });
+    while (ticks < 3)
+    {
+        terminal->pollOnce(std::chrono::milliseconds(100));
+    }
+    terminal->reactor()->removeTimer(timer);
+    terminal->feed("abc\r");
+    EXPECT_EQ(lines, std::vector<std::string>({"abc"}));
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <thread>
+#include <gtest/gtest.h>
+#include "cmdly/terminal.h"
+#include "helpers/io_mock.h"
+
+using namespace testing;
+using namespace cmdly;
+
+class PostIOMock : public IOMock
+{
+public:
+    mutable std::vector<std::string> writes;
+    int wake_ups = 0;
+
+    void write(const std::string &data) const override
+    {
+        writes.push_back(data);
+    }
+
+    void wakeUp() override
+    {
+        wake_ups++;
+    }
+};
+
+TEST(PostTextTest, checkPostedTextIsWrittenOnceAboveLine)
+{
+    auto io = std::make_shared<PostIOMock>();
+    Terminal terminal(io);
+    terminal.start("> ");
+    terminal.feed("ab");
+
+    constexpr int PRODUCERS = 4;
+    constexpr int MESSAGES = 1000;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+    {
+        producers.emplace_back([&terminal]() {
+            for (int i = 0; i < MESSAGES; ++i)
+            {
+                terminal.postText("message\n");
+            }
+        });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_EQ(io->wake_ups, 1);
+
+    io->writes.clear();
+    terminal.feed("c");
+
+    // one write: clear the line, all messages, then the prompt and line drawn again
+    ASSERT_EQ(io->writes.size(), 1);
+    auto &output = io->writes.front();
+    EXPECT_EQ(output.rfind("\r\033[K", 0), 0);
+    std::size_t count = 0;
+    for (auto pos = output.find("message\n"); pos != std::string::npos; pos = output.find("message\n", pos + 1))
+    {
+        count++;
+    }
+    EXPECT_EQ(count, PRODUCERS * MESSAGES);
+    auto redraw = output.substr(output.rfind("message\n"));
+    EXPECT_NE(redraw.find("> "), std::string::npos);
+    EXPECT_NE(redraw.find("abc"), std::string::npos);
+
+    // posting again wakes the terminal again
+    terminal.postText("again\n", TextStyle(Color::Red));
+    EXPECT_EQ(io->wake_ups, 2);
+    terminal.stop();
+}
+
+TEST(PostTextTest, checkWakeUpInterruptsGetKey)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    StandardIO io(fds[0], -1);
+
+    std::thread waker([&io]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        io.wakeUp();
+    });
+    EXPECT_EQ(io.getKey(), Key::WakeUp);
+    waker.join();
+
+    ASSERT_EQ(::write(fds[1], "x", 1), 1);
+    EXPECT_EQ(io.getKey(), cmdly::Key('x'));
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <deque>
+#include <gtest/gtest.h>
+#include "cmdly/terminal.h"
+#include "helpers/io_mock.h"
+
+using namespace cmdly;
+
+class RawModeIOMock : public IOMock
+{
+public:
+    std::deque<Key> keys = {Key('a'), Key('b'), Key('c'), Key::Enter};
+    std::deque<char> chars = {'\033', '[', '1', ';', '1', 'R'};
+    int raw_mode_enters = 0;
+    int raw_mode_exits = 0;
+    int raw_mode_depth = 0;
+
+    Key getKey() override
+    {
+        EXPECT_GT(raw_mode_depth, 0);
+        Key k = keys.front();
+        keys.pop_front();
+        return k;
+    }
+
+    char getChar() override
+    {
+        char c = chars.front();
+        chars.pop_front();
+        return c;
+    }
+
+    void enterRawMode() override
+    {
+        raw_mode_enters++;
+        raw_mode_depth++;
+    }
+
+    void exitRawMode() override
+    {
+        raw_mode_exits++;
+        raw_mode_depth--;
+    }
+};
+
+TEST(TerminalTest, checkReadLineHoldsOneRawModeSession)
+{
+    auto io = std::make_shared<RawModeIOMock>();
+    auto terminal = std::make_unique<Terminal>(io);
+
+    EXPECT_CALL(*io, write(::testing::_)).Times(::testing::AnyNumber());
+
+    auto line = terminal->readLine("prompt> ");
+    EXPECT_EQ("abc", line);
+    EXPECT_EQ(io->raw_mode_enters, 1);
+    EXPECT_EQ(io->raw_mode_exits, 1);
+    EXPECT_EQ(io->raw_mode_depth, 0);
+}
+
+TEST(TerminalTest, checkRawModeIsRestoredOnException)
+{
+    auto io = std::make_shared<RawModeIOMock>();
+    auto terminal = std::make_unique<Terminal>(io);
+
+    EXPECT_CALL(*io, write(::testing::_)).Times(::testing::AnyNumber());
+    terminal->onKeyPressed(Key('b'), [](const Key &, Line &, Cursor &, Terminal &) -> KeyPressedListener::Status {
+        throw CmdlyError("listener failed");
+    });
+
+    EXPECT_THROW(terminal->readLine("prompt> "), CmdlyError);
+    EXPECT_EQ(io->raw_mode_depth, 0);
+}
@@ -40,4 +40,77 @@ TEST(TerminalTest, checkReadLineReturnsValidCommand)
 
     auto line = terminal->readLine("prompt> ");
     EXPECT_EQ("abc", line);
-}
\ No newline at end of file
+}
+
+TEST(TerminalTest, checkReadLineWritesOncePerKey)
+{
+    auto io = std::make_shared<CustomIOMock>();
+    auto terminal = std::make_unique<Terminal>(io);
+    auto *io_mock = reinterpret_cast<CustomIOMock*>(io.get());
+
+    // prompt, one write per key and leaving bracketed paste
+    EXPECT_CALL(*io_mock, write(::testing::_)).Times(int(io_mock->keys.size()) + 2);
+
+    terminal->readLine("prompt> ");
+}
+
+TEST(TerminalTest, checkPasteIsInsertedWithOneRedrawAndOneNotification)
+{
+    auto io = std::make_shared<CustomIOMock>();
+    io->keys = {Key('>'), Key::Pasted("one\ntwo\tthree\033"), Key::Enter};
+    auto terminal = std::make_unique<Terminal>(io);
+    auto *io_mock = reinterpret_cast<CustomIOMock*>(io.get());
+    std::vector<std::string> changes;
+
+    EXPECT_CALL(*io_mock, write(::testing::_)).Times(int(io_mock->keys.size()) + 2);
+    terminal->onLineChanged([&changes](const std::string &content, Line &, Cursor &, Terminal &) {
+        changes.push_back(content);
+        return LineChangedListener::Status::OK;
+    });
+
+    auto line = terminal->readLine("prompt> ");
+    EXPECT_EQ(">one two three", line);
+    EXPECT_EQ(changes, std::vector<std::string>({">", ">one two three"}));
+}
+
+TEST(TerminalTest, checkPromptDoesNotWaitForTerminal)
+{
+    auto io = std::make_shared<CustomIOMock>();
+    auto terminal = std::make_unique<Terminal>(io);
+    auto *io_mock = reinterpret_cast<CustomIOMock*>(io.get());
+
+    EXPECT_CALL(*io_mock, write(::testing::HasSubstr("\033[6n"))).Times(0);
+    EXPECT_CALL(*io_mock, write(::testing::Not(::testing::HasSubstr("\033[6n")))).Times(::testing::AnyNumber());
+
+    terminal->readLine("prompt> ");
+    EXPECT_EQ(io_mock->chars.size(), 6);
+}
+
+TEST(TerminalTest, checkReadLineAssemblesUtf8Characters)
+{
+    auto io = std::make_shared<CustomIOMock>();
+    io->keys = {Key('z'), Key('\xC5'), Key('\x82'), Key('\xE6'), Key('\xBC'), Key('\xA2'), Key('\x82'), Key::Enter};
+    auto terminal = std::make_unique<Terminal>(io);
+
+    // a stray continuation byte is dropped
+    EXPECT_EQ(terminal->readLine("> "), "z\xC5\x82\xE6\xBC\xA2");
+}
+
+TEST(TerminalTest, checkHistorySuggestionIsShownAndAcceptedWithArrowRight)
+{
+    auto io = std::make_shared<CustomIOMock>();
+    io->keys = {Key('g'), Key('i'), Key::ArrowRight, Key::Enter};
+    auto terminal = std::make_unique<Terminal>(io);
+    terminal->history()->insert("git status");
+    auto *io_mock = reinterpret_cast<CustomIOMock*>(io.get());
+
+    // the rest of the line is shown dimmed after each typed character
+    auto dimmed = TextStyle(Color::Default, Color::Default, FontStyle::Faint).str();
+    EXPECT_CALL(*io_mock, write(::testing::HasSubstr(dimmed + "it status"))).Times(1);
+    EXPECT_CALL(*io_mock, write(::testing::HasSubstr(dimmed + "t status"))).Times(1);
+    EXPECT_CALL(*io_mock, write(::testing::Not(::testing::HasSubstr("status")))).Times(::testing::AnyNumber());
+    EXPECT_CALL(*io_mock, write(::testing::AllOf(::testing::HasSubstr("status"),
+                                                 ::testing::Not(::testing::HasSubstr(dimmed))))).Times(1);
+
+    EXPECT_EQ(terminal->readLine("> "), "git status");
+}
@@ -37,10 +37,23 @@ TEST(TerminalTest, checkWriteWithStyledTextWorksCorrectly)
     auto terminal = std::make_unique<Terminal>(io);
     auto *io_mock = reinterpret_cast<IOMock*>(io.get());
 
-    Sequence seq;
-    EXPECT_CALL(*io_mock, write("\033[38;5;1m")).InSequence(seq);
-    EXPECT_CALL(*io_mock, write("some text")).InSequence(seq);
-    EXPECT_CALL(*io_mock, write("\033[m")).InSequence(seq);
+    EXPECT_CALL(*io_mock, write("\033[38;5;1msome text\033[m")).Times(1);
 
     terminal->writeText("some text", TextStyle(Color::Red));
 }
+
+TEST(TerminalTest, checkWriteInsideFrameIsFlushedOnce)
+{
+    auto io = std::make_shared<IOMock>();
+    auto terminal = std::make_unique<Terminal>(io);
+    auto *io_mock = reinterpret_cast<IOMock*>(io.get());
+
+    EXPECT_CALL(*io_mock, write("first\033[38;5;1msecond\033[mthird")).Times(1);
+
+    {
+        Frame frame(*io);
+        terminal->writeText("first");
+        terminal->writeText("second", TextStyle(Color::Red));
+        terminal->writeText("third");
+    }
+}
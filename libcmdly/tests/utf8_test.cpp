@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2023 by Łukasz Marcin Podkalicki <lpodkalicki@gmail.com>
+ */
+
+#include <gtest/gtest.h>
+#include "cmdly/utf8.h"
+
+using namespace cmdly;
+
+TEST(Utf8Test, checkWidthOfCodePoints)
+{
+    EXPECT_EQ(utf8::width(U'a'), 1);
+    EXPECT_EQ(utf8::width(U'ł'), 1);
+    EXPECT_EQ(utf8::width(U'漢'), 2);
+    EXPECT_EQ(utf8::width(U'한'), 2);
+    EXPECT_EQ(utf8::width(0x1F600), 2);
+    EXPECT_EQ(utf8::width(0x0301), 0);
+    EXPECT_EQ(utf8::width(utf8::ZERO_WIDTH_JOINER), 0);
+}
+
+TEST(Utf8Test, checkDecodeHandlesMalformedInput)
+{
+    std::size_t length;
+    EXPECT_EQ(utf8::decode("\xC5\x82", 0, &length), U'ł');
+    EXPECT_EQ(length, 2);
+    EXPECT_EQ(utf8::decode("\xE6\xBC", 0, &length), utf8::INVALID);
+    EXPECT_EQ(length, 1);
+    EXPECT_EQ(utf8::decode("\x80", 0, &length), utf8::INVALID);
+    EXPECT_EQ(length, 1);
+}
+
+TEST(Utf8Test, checkAsciiFastPath)
+{
+    EXPECT_TRUE(utf8::isAscii(""));
+    EXPECT_TRUE(utf8::isAscii("a fairly long line of plain ascii text"));
+    EXPECT_FALSE(utf8::isAscii("a fairly long line of plain ascii text\xC5\x82"));
+    EXPECT_FALSE(utf8::isAscii("\xC5\x82 at the beginning of a fairly long line"));
+}
+
+TEST(Utf8Test, checkClusters)
+{
+    std::size_t columns;
+    // e followed by a combining acute accent is one column
+    EXPECT_EQ(utf8::clusterLength("e\xCC\x81x", 0, &columns), 3);
+    EXPECT_EQ(columns, 1);
+    // family emoji joined with ZWJ is one wide cluster
+    std::string family = "\xF0\x9F\x91\xA8\xE2\x80\x8D\xF0\x9F\x91\xA9";
+    EXPECT_EQ(utf8::clusterLength(family, 0, &columns), family.size());
+    EXPECT_EQ(columns, 2);
+    // two regional indicators make one flag, the third starts another
+    std::string flags = "\xF0\x9F\x87\xB5\xF0\x9F\x87\xB1\xF0\x9F\x87\xB5";
+    EXPECT_EQ(utf8::clusterLength(flags, 0, &columns), 8);
+    EXPECT_EQ(columns, 2);
+
+    EXPECT_EQ(utf8::columns("abc"), 3);
+    EXPECT_EQ(utf8::columns("\xE6\xBC\xA2\xE5\xAD\x97"), 4);
+}